@@ -0,0 +1,163 @@
+/*
+ * Copyright (c) 2019-2025 Sinric. All rights reserved.
+ * Licensed under Creative Commons Attribution-Share Alike (CC BY-SA)
+ *
+ * This file is part of the SinricPro ESP-IDF component
+ * (https://github.com/sinricpro/esp-idf)
+ */
+
+/*
+ * Throughput of the fixed-point waveform analyzer against a straightforward
+ * float implementation, on synthetic 50 Hz waveforms.
+ *
+ * Runs as an ESP-IDF app, or on the host:
+ *     cc -O2 -I../../include main/power_analysis_benchmark.c \
+ *        ../../src/capabilities/power_analysis.c -lm -o bench && ./bench
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <math.h>
+#include "sinricpro_power_analysis.h"
+
+#ifdef ESP_PLATFORM
+#include "esp_timer.h"
+#define now_us() esp_timer_get_time()
+#else
+#include <time.h>
+static int64_t now_us(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+#endif
+
+/* 4 kHz sampling of 50 Hz mains: 80 samples per cycle, 10 cycles per window */
+#define SAMPLE_RATE_HZ  4000
+#define MAINS_HZ        50
+#define WINDOW_PAIRS    (SAMPLE_RATE_HZ / MAINS_HZ * 10)
+#define BUFFER_PAIRS    (WINDOW_PAIRS * 4)
+#define ROUNDS          2500
+
+#define ADC_MIDPOINT    2048
+#define V_PEAK_COUNTS   1500.0
+#define I_PEAK_COUNTS   800.0
+#define V_PEAK          325.27     /* 230 V RMS */
+#define I_PEAK          7.0711     /* 5 A RMS */
+#define PHASE_DEG       30.0       /* current lags: PF 0.866 */
+
+static uint16_t buffer[BUFFER_PAIRS * 2];
+
+static void make_waveforms(void)
+{
+    const double pi = 3.14159265358979323846;
+
+    for (int n = 0; n < BUFFER_PAIRS; n++) {
+        double angle = 2.0 * pi * MAINS_HZ * n / SAMPLE_RATE_HZ;
+        buffer[2 * n] = (uint16_t)lround(ADC_MIDPOINT + V_PEAK_COUNTS * sin(angle));
+        buffer[2 * n + 1] = (uint16_t)lround(ADC_MIDPOINT + I_PEAK_COUNTS * sin(angle - PHASE_DEG * pi / 180.0));
+    }
+}
+
+/* What the application used to do: float per sample */
+static void float_reference(const uint16_t *samples, size_t pairs,
+                            float v_scale, float i_scale, sinricpro_power_reading_t *reading)
+{
+    float sum_vv = 0.0f, sum_ii = 0.0f, sum_vi = 0.0f;
+
+    for (size_t n = 0; n < pairs; n++) {
+        float v = ((float)samples[2 * n] - ADC_MIDPOINT) * v_scale;
+        float i = ((float)samples[2 * n + 1] - ADC_MIDPOINT) * i_scale;
+        sum_vv += v * v;
+        sum_ii += i * i;
+        sum_vi += v * i;
+    }
+
+    reading->voltage = sqrtf(sum_vv / pairs);
+    reading->current = sqrtf(sum_ii / pairs);
+    reading->power = sum_vi / pairs;
+    reading->apparent_power = reading->voltage * reading->current;
+    reading->reactive_power = sqrtf(fmaxf(reading->apparent_power * reading->apparent_power -
+                                          reading->power * reading->power, 0.0f));
+    reading->factor = reading->power / reading->apparent_power;
+}
+
+static void print_reading(const char *label, const sinricpro_power_reading_t *r)
+{
+    printf("%-12s %7.2f V %6.3f A %8.2f W %8.2f VA %8.2f VAR PF %.4f\n",
+           label, r->voltage, r->current, r->power, r->apparent_power, r->reactive_power, r->factor);
+}
+
+static void run_benchmark(void)
+{
+    const float v_scale = (float)(V_PEAK / V_PEAK_COUNTS);
+    const float i_scale = (float)(I_PEAK / I_PEAK_COUNTS);
+
+    make_waveforms();
+
+    sinricpro_power_analysis_config_t config = {
+        .voltage_scale = v_scale,
+        .current_scale = i_scale,
+        .voltage_offset = ADC_MIDPOINT,
+        .current_offset = ADC_MIDPOINT,
+        .adc_bits = 12,
+        .window_samples = WINDOW_PAIRS,
+    };
+    sinricpro_power_analyzer_t analyzer;
+    sinricpro_power_analyzer_init(&analyzer, &config);
+
+    sinricpro_power_reading_t reading = { 0 };
+    uint32_t windows = 0;
+
+    int64_t start = now_us();
+    for (int round = 0; round < ROUNDS; round++) {
+        const uint16_t *samples = buffer;
+        size_t pairs = BUFFER_PAIRS;
+        while (sinricpro_power_analyzer_feed(&analyzer, &samples, &pairs, &reading)) {
+            windows++;
+        }
+    }
+    int64_t fixed_us = now_us() - start;
+
+    sinricpro_power_reading_t reference = { 0 };
+    start = now_us();
+    for (int round = 0; round < ROUNDS; round++) {
+        for (int w = 0; w < BUFFER_PAIRS / WINDOW_PAIRS; w++) {
+            float_reference(buffer + 2 * w * WINDOW_PAIRS, WINDOW_PAIRS, v_scale, i_scale, &reference);
+        }
+    }
+    int64_t float_us = now_us() - start;
+
+    double total = (double)ROUNDS * BUFFER_PAIRS;
+    const double pi = 3.14159265358979323846;
+    sinricpro_power_reading_t expected = {
+        .voltage = 230.0f,
+        .current = 5.0f,
+        .power = (float)(230.0 * 5.0 * cos(PHASE_DEG * pi / 180.0)),
+        .apparent_power = 1150.0f,
+        .reactive_power = (float)(230.0 * 5.0 * sin(PHASE_DEG * pi / 180.0)),
+        .factor = (float)cos(PHASE_DEG * pi / 180.0),
+    };
+
+    print_reading("expected", &expected);
+    print_reading("fixed-point", &reading);
+    print_reading("float", &reference);
+    printf("fixed-point: %lu windows, %.0f sample pairs/s\n",
+           (unsigned long)windows, total * 1e6 / (fixed_us > 0 ? fixed_us : 1));
+    printf("float:       %.0f sample pairs/s\n",
+           total * 1e6 / (float_us > 0 ? float_us : 1));
+}
+
+#ifdef ESP_PLATFORM
+void app_main(void)
+{
+    run_benchmark();
+}
+#else
+int main(void)
+{
+    run_benchmark();
+    return 0;
+}
+#endif
@@ -136,6 +136,9 @@ static void power_sensor_task(void *pvParameters)
         ESP_LOGI(TAG, "  Reactive Power: %.1fVAR", current_reactive_power);
         ESP_LOGI(TAG, "  Power Factor: %.2f", current_power_factor);
 
+        /* Integrate every reading into the energy counter, not just the reported ones */
+        sinricpro_power_sensor_add_power_sample(my_sensor, current_power);
+
         /* Send power update every POWER_UPDATE_INTERVAL_MS */
         if ((xTaskGetTickCount() - last_update) >= pdMS_TO_TICKS(POWER_UPDATE_INTERVAL_MS)) {
             esp_err_t ret = sinricpro_power_sensor_send_power_sensor_event(
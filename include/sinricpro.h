@@ -14,6 +14,7 @@
 #include "esp_err.h"
 #include "esp_event.h"
 #include "sinricpro_types.h"
+#include "sinricpro_transport.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -47,6 +48,9 @@ typedef struct {
     bool auto_reconnect;                /**< Enable auto-reconnection */
     uint32_t reconnect_interval_ms;     /**< Reconnection interval in ms */
     uint32_t heartbeat_interval_ms;     /**< Heartbeat interval in ms (0 = use default) */
+    const sinricpro_transport_t *transport; /**< Transport (NULL = secure WebSocket) */
+    const char *server_url;             /**< Server host override (NULL = CONFIG_SINRICPRO_SERVER_URL) */
+    uint16_t server_port;               /**< Server port override (0 = CONFIG_SINRICPRO_SERVER_PORT) */
 } sinricpro_config_t;
 
 /**
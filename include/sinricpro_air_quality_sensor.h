@@ -10,6 +10,7 @@
 #define SINRICPRO_AIR_QUALITY_SENSOR_H
 
 #include "sinricpro_types.h"
+#include "sinricpro_report.h"
 #include <stdint.h>
 
 #ifdef __cplusplus
@@ -27,6 +28,16 @@ esp_err_t sinricpro_air_quality_sensor_send_air_quality_event(
     int pm10,
     const char *cause);
 
+esp_err_t sinricpro_air_quality_sensor_set_report_policy(
+    sinricpro_device_handle_t device,
+    const sinricpro_report_policy_t *policy);
+
+esp_err_t sinricpro_air_quality_sensor_push_sample(
+    sinricpro_device_handle_t device,
+    int pm1,
+    int pm2_5,
+    int pm10);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,120 @@
+/*
+ * Copyright (c) 2019-2025 Sinric. All rights reserved.
+ * Licensed under Creative Commons Attribution-Share Alike (CC BY-SA)
+ *
+ * This file is part of the SinricPro ESP-IDF component
+ * (https://github.com/sinricpro/esp-idf)
+ */
+
+#ifndef SINRICPRO_ALLOC_STATS_H
+#define SINRICPRO_ALLOC_STATS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Per-operation heap accounting.
+ *
+ * Counts the allocations made by the SDK and by cJSON while the SDK performs
+ * one logical operation on a task. Allocations made inside ESP-IDF
+ * components (esp_websocket_client, mbedtls) are not visible.
+ *
+ * Only available with CONFIG_SINRICPRO_ALLOC_STATS enabled.
+ */
+
+/**
+ * @brief Logical operations
+ *
+ * An event is accounted in two passes: building it on the calling task and
+ * signing it on the send task. Both passes add to the same totals but only
+ * the first one counts as an operation, so allocations / operations is the
+ * cost of a whole event.
+ */
+typedef enum {
+    SINRICPRO_ALLOC_OP_REQUEST = 0,  /**< Receive, verify and dispatch a frame, build the response */
+    SINRICPRO_ALLOC_OP_RESPONSE,     /**< Sign and transmit a queued response */
+    SINRICPRO_ALLOC_OP_EVENT,        /**< Build, sign and transmit an event */
+    SINRICPRO_ALLOC_OP_RECONNECT,    /**< Bring up the transport and handle the connection */
+    SINRICPRO_ALLOC_OP_MAX,
+} sinricpro_alloc_op_t;
+
+/**
+ * @brief Accounting for one operation type
+ */
+typedef struct {
+    uint32_t operations;        /**< Completed operations */
+    uint32_t allocations;       /**< Allocations across all operations */
+    uint32_t frees;             /**< Frees across all operations */
+    uint32_t max_allocations;   /**< Most allocations in a single pass */
+    uint32_t peak_bytes;        /**< Most bytes live at once within a single pass */
+    uint32_t over_budget;       /**< Passes that exceeded the declared budget */
+} sinricpro_alloc_stats_t;
+
+/**
+ * @brief Allocation budget for one operation type
+ */
+typedef struct {
+    uint32_t max_allocations;   /**< Allocations allowed per pass (0 = unlimited) */
+    uint32_t max_peak_bytes;    /**< Live bytes allowed per pass (0 = unlimited) */
+} sinricpro_alloc_budget_t;
+
+/**
+ * @brief Get the accounting for an operation type
+ *
+ * @param[in]  op    Operation type
+ * @param[out] stats Accounting
+ *
+ * @return
+ *     - ESP_OK: Success
+ *     - ESP_ERR_INVALID_ARG: Invalid arguments
+ */
+esp_err_t sinricpro_alloc_stats_get(sinricpro_alloc_op_t op, sinricpro_alloc_stats_t *stats);
+
+/**
+ * @brief Reset the accounting of every operation type
+ *
+ * Budgets are kept.
+ */
+void sinricpro_alloc_stats_reset(void);
+
+/**
+ * @brief Declare the budget of an operation type
+ *
+ * Passes that exceed it are logged and counted in over_budget.
+ *
+ * @param[in] op     Operation type
+ * @param[in] budget Budget (NULL = unlimited)
+ *
+ * @return
+ *     - ESP_OK: Success
+ *     - ESP_ERR_INVALID_ARG: Invalid operation type
+ */
+esp_err_t sinricpro_alloc_stats_set_budget(sinricpro_alloc_op_t op,
+                                            const sinricpro_alloc_budget_t *budget);
+
+/**
+ * @brief Check that no operation exceeded its budget since the last reset
+ *
+ * Intended for host and on-target tests.
+ *
+ * @return
+ *     - ESP_OK: All operations within budget
+ *     - ESP_FAIL: At least one pass exceeded its budget
+ */
+esp_err_t sinricpro_alloc_stats_check(void);
+
+/**
+ * @brief Log the accounting of every operation type
+ */
+void sinricpro_alloc_stats_log(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SINRICPRO_ALLOC_STATS_H */
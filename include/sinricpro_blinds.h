@@ -67,6 +67,7 @@ typedef bool (*sinricpro_blinds_adjust_range_value_callback_t)(
  */
 sinricpro_device_handle_t sinricpro_blinds_create(const char *device_id);
 
+#if CONFIG_SINRICPRO_CAPABILITY_POWER_STATE_CONTROLLER
 /**
  * @brief Register power state callback
  *
@@ -80,6 +81,7 @@ esp_err_t sinricpro_blinds_on_power_state(
     sinricpro_blinds_power_state_callback_t callback,
     void *user_data
 );
+#endif
 
 /**
  * @brief Register range value callback for position control
@@ -109,6 +111,7 @@ esp_err_t sinricpro_blinds_on_adjust_range_value(
     void *user_data
 );
 
+#if CONFIG_SINRICPRO_CAPABILITY_POWER_STATE_CONTROLLER
 /**
  * @brief Send power state event
  *
@@ -122,6 +125,7 @@ esp_err_t sinricpro_blinds_send_power_state_event(
     bool state,
     const char *cause
 );
+#endif
 
 /**
  * @brief Send range value event for position change
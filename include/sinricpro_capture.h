@@ -0,0 +1,156 @@
+/*
+ * Copyright (c) 2019-2025 Sinric. All rights reserved.
+ * Licensed under Creative Commons Attribution-Share Alike (CC BY-SA)
+ *
+ * This file is part of the SinricPro ESP-IDF component
+ * (https://github.com/sinricpro/esp-idf)
+ */
+
+#ifndef SINRICPRO_CAPTURE_H
+#define SINRICPRO_CAPTURE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Traffic capture and deterministic replay.
+ *
+ * Capture log format (all integers little-endian / LEB128 varints):
+ *
+ *   header:  "SPCP" | version (1 byte) | 3 reserved bytes
+ *   record:  direction (1 byte) | delta_us (varint) | length (varint) | frame bytes
+ *
+ * delta_us is the monotonic time since the previous record (or since
+ * sinricpro_capture_start() for the first one).
+ *
+ * Only available with CONFIG_SINRICPRO_CAPTURE enabled.
+ */
+
+#define SINRICPRO_CAPTURE_MAGIC    "SPCP"
+#define SINRICPRO_CAPTURE_VERSION  1
+
+/**
+ * @brief Frame direction
+ */
+typedef enum {
+    SINRICPRO_CAPTURE_INBOUND = 0,   /**< Server to device */
+    SINRICPRO_CAPTURE_OUTBOUND = 1,  /**< Device to server */
+} sinricpro_capture_direction_t;
+
+/**
+ * @brief Capture writer
+ *
+ * Receives the encoded log. Called with the capture lock held, from the
+ * task that handled the frame; keep it short (e.g., append to a RAM buffer
+ * or a file).
+ *
+ * @param[in] data    Encoded bytes
+ * @param[in] length  Number of bytes
+ * @param[in] context User context
+ *
+ * @return ESP_OK to continue capturing; any error stops the capture
+ */
+typedef esp_err_t (*sinricpro_capture_write_t)(const void *data, size_t length, void *context);
+
+/**
+ * @brief Replay reader
+ *
+ * Must fill exactly @p length bytes.
+ *
+ * @param[out] data    Destination buffer
+ * @param[in]  length  Number of bytes to read
+ * @param[in]  context User context
+ *
+ * @return ESP_OK on success, ESP_ERR_NOT_FOUND at end of log, other errors abort
+ */
+typedef esp_err_t (*sinricpro_capture_read_t)(void *data, size_t length, void *context);
+
+/**
+ * @brief Start capturing every inbound and outbound frame
+ *
+ * @param[in] writer  Log writer
+ * @param[in] context User context passed to the writer
+ *
+ * @return
+ *     - ESP_OK: Success
+ *     - ESP_ERR_INVALID_ARG: writer is NULL
+ *     - ESP_ERR_INVALID_STATE: Capture already running
+ */
+esp_err_t sinricpro_capture_start(sinricpro_capture_write_t writer, void *context);
+
+/**
+ * @brief Stop capturing
+ *
+ * @return ESP_OK on success
+ */
+esp_err_t sinricpro_capture_stop(void);
+
+/**
+ * @brief Check if a capture is running
+ *
+ * @return true if capturing
+ */
+bool sinricpro_capture_is_active(void);
+
+/**
+ * @brief Replay options
+ */
+typedef struct {
+    bool original_pacing;       /**< Reproduce recorded inter-frame timing (false = as fast as possible) */
+    uint32_t drain_timeout_ms;  /**< Time to wait for trailing outbound frames (0 = 2000) */
+} sinricpro_replay_config_t;
+
+/**
+ * @brief Replay results
+ */
+typedef struct {
+    uint32_t inbound_frames;       /**< Frames fed into the core */
+    uint32_t expected_responses;   /**< Outbound responses in the capture */
+    uint32_t matched_responses;    /**< Responses identical to the capture (createdAt and HMAC excluded) */
+    uint32_t mismatched_responses; /**< Responses that differ from the capture */
+    uint32_t missing_responses;    /**< Responses in the capture never produced */
+    uint32_t skipped_events;       /**< Outbound events in the capture (application-originated, not replayed) */
+    uint32_t unexpected_frames;    /**< Outbound frames with no counterpart in the capture */
+    uint64_t elapsed_us;           /**< Wall time of the replay */
+    float frames_per_second;       /**< Inbound frames processed per second */
+} sinricpro_replay_report_t;
+
+/**
+ * @brief Replay a capture through the core
+ *
+ * The SDK must have been started with sinricpro_transport_loopback and the
+ * APP_SECRET used during the capture. Inbound frames are injected in order;
+ * responses the core sends back are compared with the recorded ones. An
+ * inbound frame is only injected once every response recorded before it has
+ * been produced, so an unpaced replay runs as fast as the core allows while
+ * keeping the recorded ordering. Outbound events are not compared: they are
+ * raised by the application, not by the replayed traffic.
+ *
+ * @param[in]  reader  Log reader
+ * @param[in]  context User context passed to the reader
+ * @param[in]  config  Replay options (NULL = as fast as possible)
+ * @param[out] report  Results
+ *
+ * @return
+ *     - ESP_OK: Replay completed (check the report for mismatches)
+ *     - ESP_ERR_INVALID_ARG: Invalid arguments
+ *     - ESP_ERR_INVALID_VERSION: Not a capture log, or unsupported version
+ *     - ESP_ERR_INVALID_STATE: Loopback transport not active
+ *     - ESP_ERR_NO_MEM: Out of memory
+ */
+esp_err_t sinricpro_replay_run(sinricpro_capture_read_t reader,
+                                void *context,
+                                const sinricpro_replay_config_t *config,
+                                sinricpro_replay_report_t *report);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SINRICPRO_CAPTURE_H */
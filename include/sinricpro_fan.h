@@ -67,25 +67,31 @@ esp_err_t sinricpro_fan_on_power_state(
     sinricpro_power_state_callback_t callback,
     void *user_data);
 
+#if CONFIG_SINRICPRO_CAPABILITY_POWER_LEVEL_CONTROLLER
 esp_err_t sinricpro_fan_on_power_level(
     sinricpro_device_handle_t device,
     sinricpro_power_level_callback_t callback,
     void *user_data);
+#endif
 
+#if CONFIG_SINRICPRO_CAPABILITY_POWER_LEVEL_CONTROLLER
 esp_err_t sinricpro_fan_on_adjust_power_level(
     sinricpro_device_handle_t device,
     sinricpro_adjust_power_level_callback_t callback,
     void *user_data);
+#endif
 
 esp_err_t sinricpro_fan_send_power_state_event(
     sinricpro_device_handle_t device,
     bool state,
     const char *cause);
 
+#if CONFIG_SINRICPRO_CAPABILITY_POWER_LEVEL_CONTROLLER
 esp_err_t sinricpro_fan_send_power_level_event(
     sinricpro_device_handle_t device,
     int level,
     const char *cause);
+#endif
 
 #ifdef __cplusplus
 }
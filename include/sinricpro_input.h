@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2019-2025 Sinric. All rights reserved.
+ * Licensed under Creative Commons Attribution-Share Alike (CC BY-SA)
+ *
+ * This file is part of the SinricPro ESP-IDF component
+ * (https://github.com/sinricpro/esp-idf)
+ */
+
+#ifndef SINRICPRO_INPUT_H
+#define SINRICPRO_INPUT_H
+
+#include "sinricpro_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * GPIO input binding for binary sensors (CONFIG_SINRICPRO_INPUT).
+ *
+ * A bound GPIO raises an interrupt on every edge. The ISR timestamps the
+ * edge and hands it to a single dispatcher task through a lock-free ring;
+ * the dispatcher debounces in time, coalesces flapping, and sends the
+ * device's event when the settled state differs from the state last sent,
+ * at most once per event rate limit interval.
+ */
+
+/**
+ * @brief GPIO binding of a binary sensor
+ */
+typedef struct {
+    int gpio_num;               /**< GPIO with interrupt capability */
+    bool active_low;            /**< Level 0 means detected (e.g. reed switch to GND) */
+    bool pull_up;               /**< Enable the internal pull-up */
+    bool pull_down;             /**< Enable the internal pull-down */
+    uint32_t debounce_ms;       /**< Level must be stable this long to count */
+} sinricpro_input_config_t;
+
+/**
+ * @brief Default binding: active low with pull-up, 50 ms debounce
+ */
+#define SINRICPRO_INPUT_CONFIG_DEFAULT(gpio) {  \
+    .gpio_num = (gpio),                         \
+    .active_low = true,                         \
+    .pull_up = true,                            \
+    .pull_down = false,                         \
+    .debounce_ms = 50,                          \
+}
+
+/**
+ * @brief Counters of one binding
+ */
+typedef struct {
+    uint32_t edges;             /**< Edges seen by the ISR */
+    uint32_t events;            /**< Events sent */
+    uint32_t coalesced;         /**< Settled changes folded into a later event */
+    uint32_t overflows;         /**< Times the ring was full and the level was re-read */
+} sinricpro_input_stats_t;
+
+/**
+ * @brief Read the counters of a device's GPIO binding
+ *
+ * @param[in]  device Device bound with a *_bind_gpio() function
+ * @param[out] stats  Counters
+ *
+ * @return ESP_OK, or ESP_ERR_NOT_FOUND if the device has no binding
+ */
+esp_err_t sinricpro_input_get_stats(sinricpro_device_handle_t device, sinricpro_input_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SINRICPRO_INPUT_H */
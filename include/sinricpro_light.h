@@ -132,6 +132,7 @@ esp_err_t sinricpro_light_on_power_state(
     void *user_data
 );
 
+#if CONFIG_SINRICPRO_CAPABILITY_BRIGHTNESS_CONTROLLER
 /**
  * @brief Register brightness callback
  *
@@ -145,7 +146,9 @@ esp_err_t sinricpro_light_on_brightness(
     sinricpro_light_brightness_callback_t callback,
     void *user_data
 );
+#endif
 
+#if CONFIG_SINRICPRO_CAPABILITY_BRIGHTNESS_CONTROLLER
 /**
  * @brief Register adjust brightness callback
  *
@@ -159,7 +162,9 @@ esp_err_t sinricpro_light_on_adjust_brightness(
     sinricpro_light_adjust_brightness_callback_t callback,
     void *user_data
 );
+#endif
 
+#if CONFIG_SINRICPRO_CAPABILITY_COLOR_CONTROLLER
 /**
  * @brief Register color callback
  *
@@ -173,7 +178,9 @@ esp_err_t sinricpro_light_on_color(
     sinricpro_light_color_callback_t callback,
     void *user_data
 );
+#endif
 
+#if CONFIG_SINRICPRO_CAPABILITY_COLOR_TEMPERATURE_CONTROLLER
 /**
  * @brief Register color temperature callback
  *
@@ -187,7 +194,9 @@ esp_err_t sinricpro_light_on_color_temperature(
     sinricpro_light_color_temperature_callback_t callback,
     void *user_data
 );
+#endif
 
+#if CONFIG_SINRICPRO_CAPABILITY_COLOR_TEMPERATURE_CONTROLLER
 /**
  * @brief Register adjust color temperature callback
  *
@@ -201,6 +210,7 @@ esp_err_t sinricpro_light_on_adjust_color_temperature(
     sinricpro_light_adjust_color_temperature_callback_t callback,
     void *user_data
 );
+#endif
 
 /**
  * @brief Send power state event
@@ -216,6 +226,7 @@ esp_err_t sinricpro_light_send_power_state_event(
     const char *cause
 );
 
+#if CONFIG_SINRICPRO_CAPABILITY_BRIGHTNESS_CONTROLLER
 /**
  * @brief Send brightness event
  *
@@ -229,7 +240,9 @@ esp_err_t sinricpro_light_send_brightness_event(
     int brightness,
     const char *cause
 );
+#endif
 
+#if CONFIG_SINRICPRO_CAPABILITY_COLOR_CONTROLLER
 /**
  * @brief Send color event
  *
@@ -243,7 +256,9 @@ esp_err_t sinricpro_light_send_color_event(
     const sinricpro_light_color_t *color,
     const char *cause
 );
+#endif
 
+#if CONFIG_SINRICPRO_CAPABILITY_COLOR_TEMPERATURE_CONTROLLER
 /**
  * @brief Send color temperature event
  *
@@ -257,6 +272,7 @@ esp_err_t sinricpro_light_send_color_temperature_event(
     int color_temperature,
     const char *cause
 );
+#endif
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) 2019-2025 Sinric. All rights reserved.
+ * Licensed under Creative Commons Attribution-Share Alike (CC BY-SA)
+ *
+ * This file is part of the SinricPro ESP-IDF component
+ * (https://github.com/sinricpro/esp-idf)
+ */
+
+#ifndef SINRICPRO_LOADGEN_H
+#define SINRICPRO_LOADGEN_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Local stand-in server and load generator.
+ *
+ * Plays the SinricPro server over the loopback transport: checks the
+ * appkey/deviceids handshake, sends the timestamp message, then issues
+ * signed requests across the configured devices and actions, verifies the
+ * HMAC of every response and event the SDK sends back, and reports
+ * throughput and latency percentiles.
+ *
+ * Only available with CONFIG_SINRICPRO_LOADGEN enabled.
+ */
+
+/**
+ * @brief One entry of a request mix
+ */
+typedef struct {
+    const char *action;       /**< Action name (e.g., "setPowerState") */
+    const char *value_json;   /**< Request "value" object (NULL = built-in sample value) */
+    uint32_t weight;          /**< Relative weight (0 = never sent) */
+} sinricpro_loadgen_mix_entry_t;
+
+/**
+ * @brief Load generator configuration
+ */
+typedef struct {
+    const char *app_key;                        /**< APP_KEY the SDK must announce */
+    const char *app_secret;                     /**< APP_SECRET used to sign and verify */
+    const char *const *device_ids;              /**< Target devices */
+    size_t device_count;                        /**< Number of device IDs */
+    const sinricpro_loadgen_mix_entry_t *mix;   /**< Request mix (NULL = every action, equal weight) */
+    size_t mix_count;                           /**< Number of mix entries */
+    uint32_t request_count;                     /**< Requests to send */
+    uint32_t requests_per_second;               /**< Offered load (0 = as fast as possible) */
+    uint32_t max_in_flight;                     /**< Outstanding requests allowed (0 = 1) */
+    uint32_t response_timeout_ms;               /**< Per-request timeout (0 = 5000) */
+    uint32_t seed;                              /**< Seed for the request mix (0 = fixed default) */
+} sinricpro_loadgen_config_t;
+
+/**
+ * @brief Load generator results
+ */
+typedef struct {
+    bool handshake_ok;              /**< appkey and deviceids matched the configuration */
+    uint32_t requests_sent;         /**< Requests injected */
+    uint32_t responses_received;    /**< Responses matched to a request */
+    uint32_t responses_succeeded;   /**< Responses with "success": true */
+    uint32_t timeouts;              /**< Requests without a response in time */
+    uint32_t signature_failures;    /**< Frames from the SDK with a bad HMAC */
+    uint32_t unmatched_frames;      /**< Frames that matched no outstanding request */
+    uint32_t events_received;       /**< Events sent by the SDK during the run */
+    uint64_t elapsed_us;            /**< Wall time of the run */
+    float requests_per_second;      /**< Completed requests per second */
+    uint32_t latency_min_us;        /**< Request-to-response latency */
+    uint32_t latency_p50_us;
+    uint32_t latency_p90_us;
+    uint32_t latency_p99_us;
+    uint32_t latency_max_us;
+} sinricpro_loadgen_report_t;
+
+/**
+ * @brief Run the load generator
+ *
+ * The SDK must have been started with sinricpro_transport_loopback and the
+ * same APP_KEY/APP_SECRET. Blocks until all requests completed or timed out.
+ *
+ * @param[in]  config Load generator configuration
+ * @param[out] report Results
+ *
+ * @return
+ *     - ESP_OK: Run completed (check the report for failures)
+ *     - ESP_ERR_INVALID_ARG: Invalid configuration
+ *     - ESP_ERR_INVALID_STATE: Loopback transport not active
+ *     - ESP_ERR_NO_MEM: Out of memory
+ */
+esp_err_t sinricpro_loadgen_run(const sinricpro_loadgen_config_t *config,
+                                 sinricpro_loadgen_report_t *report);
+
+/**
+ * @brief Log a report
+ *
+ * @param[in] report Results from sinricpro_loadgen_run()
+ */
+void sinricpro_loadgen_log_report(const sinricpro_loadgen_report_t *report);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SINRICPRO_LOADGEN_H */
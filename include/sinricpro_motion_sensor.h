@@ -10,6 +10,7 @@
 #define SINRICPRO_MOTION_SENSOR_H
 
 #include "sinricpro_types.h"
+#include "sinricpro_input.h"
 #include <stdbool.h>
 
 #ifdef __cplusplus
@@ -48,6 +49,12 @@ esp_err_t sinricpro_motion_sensor_send_motion_event(
     bool detected,
     const char *cause);
 
+#if CONFIG_SINRICPRO_INPUT
+esp_err_t sinricpro_motion_sensor_bind_gpio(
+    sinricpro_device_handle_t device,
+    const sinricpro_input_config_t *config);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) 2019-2025 Sinric. All rights reserved.
+ * Licensed under Creative Commons Attribution-Share Alike (CC BY-SA)
+ *
+ * This file is part of the SinricPro ESP-IDF component
+ * (https://github.com/sinricpro/esp-idf)
+ */
+
+#ifndef SINRICPRO_POWER_ANALYSIS_H
+#define SINRICPRO_POWER_ANALYSIS_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Waveform analysis for power metering.
+ *
+ * Takes raw voltage and current ADC samples, interleaved as
+ * v0, i0, v1, i1, ... (the layout of a two-channel continuous-mode ADC
+ * buffer once the data bits are extracted), and turns each window of
+ * samples into RMS values, real, apparent and reactive power and power
+ * factor. The sample loop runs in integer arithmetic only; floating point
+ * is used once per window.
+ *
+ * The analyzer does not allocate and has no SDK dependencies, so it can be
+ * used standalone. Power sensors run one through
+ * sinricpro_power_sensor_process_samples().
+ */
+
+/**
+ * @brief Calibration and windowing of an analyzer
+ */
+typedef struct {
+    float voltage_scale;        /**< Volts per ADC count */
+    float current_scale;        /**< Amps per ADC count */
+    uint16_t voltage_offset;    /**< ADC count at 0 V (residual DC is removed per window) */
+    uint16_t current_offset;    /**< ADC count at 0 A */
+    uint8_t adc_bits;           /**< Data bits per sample, 1..13; higher bits are masked off */
+    uint32_t window_samples;    /**< Sample pairs per reading; use whole mains cycles */
+} sinricpro_power_analysis_config_t;
+
+/**
+ * @brief Result of one window
+ */
+typedef struct {
+    float voltage;              /**< RMS voltage (V) */
+    float current;              /**< RMS current (A) */
+    float power;                /**< Real power (W) */
+    float apparent_power;       /**< Apparent power (VA) */
+    float reactive_power;       /**< Reactive power magnitude (VAR) */
+    float factor;               /**< Power factor, power / apparent_power */
+} sinricpro_power_reading_t;
+
+/**
+ * @brief Analyzer state (caller-owned, initialize with sinricpro_power_analyzer_init())
+ */
+typedef struct {
+    sinricpro_power_analysis_config_t config;
+    uint16_t mask;
+    uint32_t count;             /**< Sample pairs in the current window */
+    int64_t sum_v;
+    int64_t sum_i;
+    int64_t sum_vv;
+    int64_t sum_ii;
+    int64_t sum_vi;
+} sinricpro_power_analyzer_t;
+
+/**
+ * @brief Initialize an analyzer
+ *
+ * @param[out] analyzer Analyzer
+ * @param[in]  config   Calibration and window size
+ *
+ * @return true on success, false if config is invalid
+ */
+bool sinricpro_power_analyzer_init(sinricpro_power_analyzer_t *analyzer,
+                                   const sinricpro_power_analysis_config_t *config);
+
+/**
+ * @brief Feed samples until the end of the buffer or of a window
+ *
+ * Advances *samples and decrements *pairs past the samples consumed. Call
+ * in a loop to handle buffers that span several windows:
+ *
+ *     while (sinricpro_power_analyzer_feed(&analyzer, &buf, &pairs, &reading)) {
+ *         ... use reading ...
+ *     }
+ *
+ * @param[in]     analyzer Analyzer
+ * @param[in,out] samples  Interleaved voltage/current samples
+ * @param[in,out] pairs    Sample pairs left in the buffer
+ * @param[out]    reading  Filled when a window completes
+ *
+ * @return true if a window completed and reading was filled
+ */
+bool sinricpro_power_analyzer_feed(sinricpro_power_analyzer_t *analyzer,
+                                   const uint16_t **samples,
+                                   size_t *pairs,
+                                   sinricpro_power_reading_t *reading);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SINRICPRO_POWER_ANALYSIS_H */
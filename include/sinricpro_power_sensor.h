@@ -10,6 +10,8 @@
 #define SINRICPRO_POWER_SENSOR_H
 
 #include "sinricpro_types.h"
+#include "sinricpro_report.h"
+#include "sinricpro_power_analysis.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -29,6 +31,39 @@ esp_err_t sinricpro_power_sensor_send_power_sensor_event(
     float factor,
     const char *cause);
 
+esp_err_t sinricpro_power_sensor_add_power_sample(
+    sinricpro_device_handle_t device,
+    float power);
+
+esp_err_t sinricpro_power_sensor_get_energy(
+    sinricpro_device_handle_t device,
+    double *total_wh,
+    double *interval_wh);
+
+esp_err_t sinricpro_power_sensor_reset_energy(sinricpro_device_handle_t device);
+
+esp_err_t sinricpro_power_sensor_set_report_policy(
+    sinricpro_device_handle_t device,
+    const sinricpro_report_policy_t *policy);
+
+esp_err_t sinricpro_power_sensor_push_sample(
+    sinricpro_device_handle_t device,
+    float voltage,
+    float current,
+    float power,
+    float apparent_power,
+    float reactive_power,
+    float factor);
+
+esp_err_t sinricpro_power_sensor_set_analysis(
+    sinricpro_device_handle_t device,
+    const sinricpro_power_analysis_config_t *config);
+
+esp_err_t sinricpro_power_sensor_process_samples(
+    sinricpro_device_handle_t device,
+    const uint16_t *samples,
+    size_t pairs);
+
 #ifdef __cplusplus
 }
 #endif
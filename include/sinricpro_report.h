@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2019-2025 Sinric. All rights reserved.
+ * Licensed under Creative Commons Attribution-Share Alike (CC BY-SA)
+ *
+ * This file is part of the SinricPro ESP-IDF component
+ * (https://github.com/sinricpro/esp-idf)
+ */
+
+#ifndef SINRICPRO_REPORT_H
+#define SINRICPRO_REPORT_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Sensor reporting policy.
+ *
+ * Sensors that take a policy accept samples at any rate through their
+ * *_push_sample() function. The samples since the last report are folded
+ * into one value per reading with constant memory, and a report is sent
+ * (cause PERIODIC_POLL) when
+ *     - min_interval_ms has passed since the last report, and
+ *     - some reading moved past a threshold from the value last reported,
+ *       or max_interval_ms has passed.
+ *
+ * Decisions are taken when a sample is pushed; no timer runs in between.
+ */
+
+/**
+ * @brief How the samples between two reports are summarized
+ */
+typedef enum {
+    SINRICPRO_REPORT_LAST = 0,  /**< Most recent sample */
+    SINRICPRO_REPORT_MEAN,      /**< Arithmetic mean */
+    SINRICPRO_REPORT_MIN,       /**< Smallest sample */
+    SINRICPRO_REPORT_MAX,       /**< Largest sample */
+    SINRICPRO_REPORT_MEDIAN,    /**< Median (P-square estimate beyond five samples) */
+} sinricpro_report_aggregate_t;
+
+/**
+ * @brief Reporting policy of a sensor
+ *
+ * With both thresholds 0, any change is reported. With both set, crossing
+ * either one is enough.
+ */
+typedef struct {
+    float absolute_threshold;       /**< Change in reading units that triggers a report (0 = off) */
+    float relative_threshold;       /**< Change as a fraction of the reported value, e.g. 0.05 (0 = off) */
+    uint32_t min_interval_ms;       /**< Shortest time between reports (raised to the sensor event limit) */
+    uint32_t max_interval_ms;       /**< Report at least this often, even unchanged (0 = off) */
+    sinricpro_report_aggregate_t aggregate;  /**< Summary of the samples between reports */
+} sinricpro_report_policy_t;
+
+/**
+ * @brief Default policy: mean over one-minute windows, report on any change
+ */
+#define SINRICPRO_REPORT_POLICY_DEFAULT() {     \
+    .absolute_threshold = 0.0f,                 \
+    .relative_threshold = 0.0f,                 \
+    .min_interval_ms = 60000,                   \
+    .max_interval_ms = 0,                       \
+    .aggregate = SINRICPRO_REPORT_MEAN,         \
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SINRICPRO_REPORT_H */
@@ -39,21 +39,45 @@ typedef bool (*sinricpro_speaker_mode_callback_t)(const char *device_id, const c
 sinricpro_device_handle_t sinricpro_speaker_create(const char *device_id);
 
 esp_err_t sinricpro_speaker_on_power_state(sinricpro_device_handle_t device, sinricpro_speaker_power_state_callback_t callback, void *user_data);
+#if CONFIG_SINRICPRO_CAPABILITY_VOLUME_CONTROLLER
 esp_err_t sinricpro_speaker_on_volume(sinricpro_device_handle_t device, sinricpro_speaker_volume_callback_t callback, void *user_data);
 esp_err_t sinricpro_speaker_on_adjust_volume(sinricpro_device_handle_t device, sinricpro_speaker_adjust_volume_callback_t callback, void *user_data);
+#endif
+#if CONFIG_SINRICPRO_CAPABILITY_MUTE_CONTROLLER
 esp_err_t sinricpro_speaker_on_mute(sinricpro_device_handle_t device, sinricpro_speaker_mute_callback_t callback, void *user_data);
+#endif
+#if CONFIG_SINRICPRO_CAPABILITY_MEDIA_CONTROLLER
 esp_err_t sinricpro_speaker_on_media_control(sinricpro_device_handle_t device, sinricpro_speaker_media_control_callback_t callback, void *user_data);
+#endif
+#if CONFIG_SINRICPRO_CAPABILITY_INPUT_CONTROLLER
 esp_err_t sinricpro_speaker_on_input(sinricpro_device_handle_t device, sinricpro_speaker_input_callback_t callback, void *user_data);
+#endif
+#if CONFIG_SINRICPRO_CAPABILITY_EQUALIZER_CONTROLLER
 esp_err_t sinricpro_speaker_on_equalizer(sinricpro_device_handle_t device, sinricpro_speaker_equalizer_callback_t callback, void *user_data);
+#endif
+#if CONFIG_SINRICPRO_CAPABILITY_MODE_CONTROLLER
 esp_err_t sinricpro_speaker_on_mode(sinricpro_device_handle_t device, sinricpro_speaker_mode_callback_t callback, void *user_data);
+#endif
 
 esp_err_t sinricpro_speaker_send_power_state_event(sinricpro_device_handle_t device, bool state, const char *cause);
+#if CONFIG_SINRICPRO_CAPABILITY_VOLUME_CONTROLLER
 esp_err_t sinricpro_speaker_send_volume_event(sinricpro_device_handle_t device, int volume, const char *cause);
+#endif
+#if CONFIG_SINRICPRO_CAPABILITY_MUTE_CONTROLLER
 esp_err_t sinricpro_speaker_send_mute_event(sinricpro_device_handle_t device, bool mute, const char *cause);
+#endif
+#if CONFIG_SINRICPRO_CAPABILITY_MEDIA_CONTROLLER
 esp_err_t sinricpro_speaker_send_media_control_event(sinricpro_device_handle_t device, const char *control, const char *cause);
+#endif
+#if CONFIG_SINRICPRO_CAPABILITY_INPUT_CONTROLLER
 esp_err_t sinricpro_speaker_send_input_event(sinricpro_device_handle_t device, const char *input, const char *cause);
+#endif
+#if CONFIG_SINRICPRO_CAPABILITY_EQUALIZER_CONTROLLER
 esp_err_t sinricpro_speaker_send_equalizer_event(sinricpro_device_handle_t device, const sinricpro_speaker_equalizer_bands_t *bands, const char *cause);
+#endif
+#if CONFIG_SINRICPRO_CAPABILITY_MODE_CONTROLLER
 esp_err_t sinricpro_speaker_send_mode_event(sinricpro_device_handle_t device, const char *mode, const char *cause);
+#endif
 
 #ifdef __cplusplus
 }
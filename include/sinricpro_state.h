@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) 2019-2025 Sinric. All rights reserved.
+ * Licensed under Creative Commons Attribution-Share Alike (CC BY-SA)
+ *
+ * This file is part of the SinricPro ESP-IDF component
+ * (https://github.com/sinricpro/esp-idf)
+ */
+
+#ifndef SINRICPRO_STATE_H
+#define SINRICPRO_STATE_H
+
+#include <stdbool.h>
+#include "sinricpro_types.h"
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Device state shadow.
+ *
+ * The core remembers the last value of every property a device reported,
+ * either in an event or in a successful response. Each value is filed under
+ * the action that sets it ("setPowerState", "setRangeValue",
+ * "targetTemperature", ...) and the property name in the message ("state",
+ * "rangeValue", "temperature", ...), so adjust requests update the same
+ * entry as set requests.
+ *
+ * The shadow is used to
+ *     - drop events whose value matches what the server already has,
+ *     - answer adjust requests (adjustRangeValue, adjustTargetTemperature,
+ *       ...) with the resulting absolute value instead of the delta,
+ *     - let the application read the reported state back.
+ *
+ * Each device holds CONFIG_SINRICPRO_STATE_SHADOW_SLOTS properties; once
+ * they are taken, further properties are not shadowed. Push notifications,
+ * media controls and power usage reports are never shadowed or dropped.
+ *
+ * Only available with CONFIG_SINRICPRO_STATE_SHADOW enabled.
+ */
+
+/* Longest string value kept verbatim (including the terminator) */
+#define SINRICPRO_STATE_STRING_LEN 16
+
+/**
+ * @brief Type of a shadowed value
+ */
+typedef enum {
+    SINRICPRO_STATE_NUMBER = 1,
+    SINRICPRO_STATE_BOOL,
+    SINRICPRO_STATE_STRING,
+} sinricpro_state_type_t;
+
+/**
+ * @brief Shadowed value
+ */
+typedef struct {
+    sinricpro_state_type_t type;
+    union {
+        double number;
+        bool boolean;
+        char string[SINRICPRO_STATE_STRING_LEN];
+    };
+} sinricpro_state_value_t;
+
+/**
+ * @brief Read the last reported value of a property
+ *
+ * Answered from the shadow; no callback is invoked.
+ *
+ * Example: the brightness of a light
+ * @code
+ * sinricpro_state_value_t value;
+ * if (sinricpro_state_get(light, "setBrightness", "brightness", &value) == ESP_OK) {
+ *     int brightness = (int)value.number;
+ * }
+ * @endcode
+ *
+ * @param[in]  device   Device handle
+ * @param[in]  action   Action that sets the property (e.g., "setPowerState")
+ * @param[in]  property Property name (e.g., "state")
+ * @param[out] value    Value
+ *
+ * @return
+ *     - ESP_OK: Success
+ *     - ESP_ERR_INVALID_ARG: Invalid arguments
+ *     - ESP_ERR_NOT_FOUND: Property not reported yet (or not shadowed)
+ *     - ESP_ERR_NOT_SUPPORTED: Property is an object, an array or a string
+ *       longer than SINRICPRO_STATE_STRING_LEN - 1; only a digest is kept
+ */
+esp_err_t sinricpro_state_get(sinricpro_device_handle_t device,
+                              const char *action,
+                              const char *property,
+                              sinricpro_state_value_t *value);
+
+/**
+ * @brief Forget the shadowed state of a device
+ *
+ * The next event for each property is sent whatever its value, e.g. to
+ * re-publish the full state after the server lost it.
+ *
+ * @param[in] device Device handle
+ *
+ * @return
+ *     - ESP_OK: Success
+ *     - ESP_ERR_INVALID_ARG: device is NULL
+ */
+esp_err_t sinricpro_state_clear(sinricpro_device_handle_t device);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SINRICPRO_STATE_H */
@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) 2019-2025 Sinric. All rights reserved.
+ * Licensed under Creative Commons Attribution-Share Alike (CC BY-SA)
+ *
+ * This file is part of the SinricPro ESP-IDF component
+ * (https://github.com/sinricpro/esp-idf)
+ */
+
+#ifndef SINRICPRO_STATIC_H
+#define SINRICPRO_STATIC_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Static allocation mode.
+ *
+ * Devices, capability controllers and event limiters are carved from an
+ * object arena, in creation order, so each device is one contiguous run of
+ * memory. Messages, cJSON trees, queues and transport buffers use fixed
+ * block pools. Both are sized at compile time through Kconfig; the SDK makes
+ * no heap allocations of its own.
+ *
+ * Only available with CONFIG_SINRICPRO_STATIC_ALLOCATION enabled.
+ */
+
+/**
+ * @brief Usage of one block pool
+ */
+typedef struct {
+    size_t block_size;      /**< Bytes per block */
+    uint32_t blocks;        /**< Blocks in the pool */
+    uint32_t in_use;        /**< Blocks currently allocated */
+    uint32_t peak;          /**< Most blocks allocated at once */
+    uint32_t failures;      /**< Allocations that found no free block */
+} sinricpro_static_pool_usage_t;
+
+/**
+ * @brief Usage of the static memory
+ */
+typedef struct {
+    size_t arena_size;                      /**< Object arena size */
+    size_t arena_used;                      /**< Object arena bytes handed out */
+    sinricpro_static_pool_usage_t small;    /**< cJSON nodes and short strings */
+    sinricpro_static_pool_usage_t medium;   /**< Messages and print buffers */
+    sinricpro_static_pool_usage_t large;    /**< Receive buffer and long messages */
+} sinricpro_static_usage_t;
+
+/**
+ * @brief Get the usage of the static memory
+ *
+ * Run the application under its heaviest traffic and size the Kconfig pools
+ * from the peaks.
+ *
+ * @param[out] usage Usage
+ *
+ * @return
+ *     - ESP_OK: Success
+ *     - ESP_ERR_INVALID_ARG: usage is NULL
+ */
+esp_err_t sinricpro_static_get_usage(sinricpro_static_usage_t *usage);
+
+/**
+ * @brief Log the usage of the static memory
+ */
+void sinricpro_static_log_usage(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SINRICPRO_STATIC_H */
@@ -102,6 +102,7 @@ esp_err_t sinricpro_switch_on_power_state(
     void *user_data
 );
 
+#if CONFIG_SINRICPRO_CAPABILITY_SETTING_CONTROLLER
 /**
  * @brief Register Setting callback
  *
@@ -123,6 +124,7 @@ esp_err_t sinricpro_switch_on_setting(
     sinricpro_setting_callback_t callback,
     void *user_data
 );
+#endif
 
 /**
  * @brief Send PowerState event to server
@@ -151,6 +153,7 @@ esp_err_t sinricpro_switch_send_power_state_event(
     const char *cause
 );
 
+#if CONFIG_SINRICPRO_CAPABILITY_PUSH_NOTIFICATION
 /**
  * @brief Send push notification to server
  *
@@ -173,6 +176,7 @@ esp_err_t sinricpro_switch_send_notification(
     sinricpro_device_handle_t device,
     const char *message
 );
+#endif
 
 /**
  * @brief Delete switch device
@@ -10,6 +10,7 @@
 #define SINRICPRO_TEMPERATURE_SENSOR_H
 
 #include "sinricpro_types.h"
+#include "sinricpro_report.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -25,6 +26,15 @@ esp_err_t sinricpro_temperature_sensor_send_temperature_event(
     float humidity,
     const char *cause);
 
+esp_err_t sinricpro_temperature_sensor_set_report_policy(
+    sinricpro_device_handle_t device,
+    const sinricpro_report_policy_t *policy);
+
+esp_err_t sinricpro_temperature_sensor_push_sample(
+    sinricpro_device_handle_t device,
+    float temperature,
+    float humidity);
+
 #ifdef __cplusplus
 }
 #endif
@@ -10,6 +10,7 @@
 #define SINRICPRO_THERMOSTAT_H
 
 #include "sinricpro_types.h"
+#include "sinricpro_report.h"
 #include <stdbool.h>
 #include <stdint.h>
 
@@ -92,6 +93,7 @@ typedef bool (*sinricpro_thermostat_adjust_temperature_callback_t)(
  */
 sinricpro_device_handle_t sinricpro_thermostat_create(const char *device_id);
 
+#if CONFIG_SINRICPRO_CAPABILITY_POWER_STATE_CONTROLLER
 /**
  * @brief Register power state callback
  *
@@ -105,6 +107,7 @@ esp_err_t sinricpro_thermostat_on_power_state(
     sinricpro_thermostat_power_state_callback_t callback,
     void *user_data
 );
+#endif
 
 /**
  * @brief Register thermostat mode callback
@@ -148,6 +151,7 @@ esp_err_t sinricpro_thermostat_on_adjust_target_temperature(
     void *user_data
 );
 
+#if CONFIG_SINRICPRO_CAPABILITY_POWER_STATE_CONTROLLER
 /**
  * @brief Send power state event
  *
@@ -161,6 +165,7 @@ esp_err_t sinricpro_thermostat_send_power_state_event(
     bool state,
     const char *cause
 );
+#endif
 
 /**
  * @brief Send thermostat mode event
@@ -190,6 +195,7 @@ esp_err_t sinricpro_thermostat_send_target_temperature_event(
     const char *cause
 );
 
+#if CONFIG_SINRICPRO_CAPABILITY_TEMPERATURE_SENSOR
 /**
  * @brief Send current temperature and humidity event
  *
@@ -206,6 +212,35 @@ esp_err_t sinricpro_thermostat_send_temperature_event(
     const char *cause
 );
 
+/**
+ * @brief Set the reporting policy of the current temperature
+ *
+ * @param[in] device Device handle
+ * @param[in] policy Reporting policy (see sinricpro_report.h)
+ * @return ESP_OK on success, error code otherwise
+ */
+esp_err_t sinricpro_thermostat_set_temperature_report_policy(
+    sinricpro_device_handle_t device,
+    const sinricpro_report_policy_t *policy
+);
+
+/**
+ * @brief Push a temperature and humidity sample
+ *
+ * A currentTemperature event is sent when the reporting policy says so.
+ *
+ * @param[in] device Device handle
+ * @param[in] temperature Current temperature in Celsius
+ * @param[in] humidity Current humidity in percentage
+ * @return ESP_OK on success (sent or not due), ESP_ERR_INVALID_STATE without a policy
+ */
+esp_err_t sinricpro_thermostat_push_temperature_sample(
+    sinricpro_device_handle_t device,
+    float temperature,
+    float humidity
+);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,177 @@
+/*
+ * Copyright (c) 2019-2025 Sinric. All rights reserved.
+ * Licensed under Creative Commons Attribution-Share Alike (CC BY-SA)
+ *
+ * This file is part of the SinricPro ESP-IDF component
+ * (https://github.com/sinricpro/esp-idf)
+ */
+
+#ifndef SINRICPRO_TRANSPORT_H
+#define SINRICPRO_TRANSPORT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Transport instance handle (opaque, owned by the transport)
+ */
+typedef void* sinricpro_transport_handle_t;
+
+/**
+ * @brief Receive callback
+ *
+ * Called by the transport for every complete text frame received.
+ * The data is always null-terminated.
+ *
+ * @param[in] data    Message data
+ * @param[in] length  Message length (excluding terminator)
+ * @param[in] context User context
+ */
+typedef void (*sinricpro_transport_receive_callback_t)(const char *data, size_t length, void *context);
+
+/**
+ * @brief Connection state callback
+ *
+ * @param[in] context User context
+ */
+typedef void (*sinricpro_transport_state_callback_t)(void *context);
+
+/**
+ * @brief Transport callbacks structure
+ */
+typedef struct {
+    sinricpro_transport_receive_callback_t on_receive;    /**< Frame received */
+    sinricpro_transport_state_callback_t on_connected;    /**< Link established */
+    sinricpro_transport_state_callback_t on_disconnected; /**< Link lost */
+    void *context;                                         /**< Passed to every callback */
+} sinricpro_transport_callbacks_t;
+
+/**
+ * @brief Transport configuration
+ *
+ * All strings are only guaranteed to be valid during init();
+ * transports must copy what they need.
+ */
+typedef struct {
+    const char *server_url;   /**< Server host name (e.g., "ws.sinric.pro") */
+    uint16_t server_port;     /**< Server port */
+    const char *path;         /**< WebSocket path (e.g., "/") */
+    const char *app_key;      /**< APP_KEY sent in the "appkey" header */
+    const char *device_ids;   /**< Semicolon-separated device IDs for the "deviceids" header */
+} sinricpro_transport_config_t;
+
+/**
+ * @brief Transport interface
+ *
+ * A transport moves complete text frames between the SDK core and a
+ * SinricPro server. Select one by setting sinricpro_config_t::transport
+ * before calling sinricpro_init().
+ */
+typedef struct sinricpro_transport {
+    const char *name;  /**< Short name used in logs */
+
+    /** Create a transport instance. Must not connect yet. */
+    esp_err_t (*init)(const sinricpro_transport_config_t *config,
+                      const sinricpro_transport_callbacks_t *callbacks,
+                      sinricpro_transport_handle_t *out_handle);
+
+    /** Start connecting (asynchronously; on_connected reports success). */
+    esp_err_t (*start)(sinricpro_transport_handle_t handle);
+
+    /** Close the connection. */
+    esp_err_t (*stop)(sinricpro_transport_handle_t handle);
+
+    /** Stop (if needed) and free the instance. */
+    esp_err_t (*deinit)(sinricpro_transport_handle_t handle);
+
+    /** Return true while frames can be sent. */
+    bool (*is_connected)(sinricpro_transport_handle_t handle);
+
+    /** Send one text frame (length 0 = use strlen). */
+    esp_err_t (*send)(sinricpro_transport_handle_t handle, const char *message, size_t length);
+} sinricpro_transport_t;
+
+/**
+ * @brief Secure WebSocket transport (wss://) using esp_websocket_client
+ *
+ * This is the default transport.
+ */
+extern const sinricpro_transport_t sinricpro_transport_websocket;
+
+/**
+ * @brief Plain WebSocket transport (ws://) using esp_websocket_client
+ *
+ * Intended for a local stand-in server on a trusted network.
+ */
+extern const sinricpro_transport_t sinricpro_transport_websocket_plain;
+
+/**
+ * @brief In-memory loopback transport
+ *
+ * Frames sent by the SDK are handed to the sink registered with
+ * sinricpro_loopback_set_sink(); frames passed to sinricpro_loopback_inject()
+ * are delivered to the SDK as if they came from the server. No network is
+ * used, which makes benchmarks and tests deterministic.
+ */
+extern const sinricpro_transport_t sinricpro_transport_loopback;
+
+/**
+ * @brief Loopback outbound sink
+ *
+ * @param[in] data    Frame sent by the SDK (null-terminated)
+ * @param[in] length  Frame length
+ * @param[in] context User context
+ */
+typedef void (*sinricpro_loopback_sink_t)(const char *data, size_t length, void *context);
+
+/**
+ * @brief Set the sink receiving frames sent through the loopback transport
+ *
+ * The sink runs on the task that sends the frame.
+ *
+ * @param[in] sink    Sink function (NULL = discard outbound frames)
+ * @param[in] context User context
+ *
+ * @return ESP_OK on success
+ */
+esp_err_t sinricpro_loopback_set_sink(sinricpro_loopback_sink_t sink, void *context);
+
+/**
+ * @brief Deliver a frame to the SDK as if received from the server
+ *
+ * The frame is processed synchronously on the caller's task.
+ *
+ * @param[in] data   Frame data
+ * @param[in] length Frame length (0 = use strlen)
+ *
+ * @return
+ *     - ESP_OK: Success
+ *     - ESP_ERR_INVALID_ARG: Invalid arguments
+ *     - ESP_ERR_INVALID_STATE: Loopback transport not connected
+ *     - ESP_ERR_NO_MEM: Out of memory
+ */
+esp_err_t sinricpro_loopback_inject(const char *data, size_t length);
+
+/**
+ * @brief Get the handshake headers announced over the loopback transport
+ *
+ * @param[out] app_key    APP_KEY announced (may be NULL)
+ * @param[out] device_ids Device IDs announced (may be NULL)
+ *
+ * @return
+ *     - ESP_OK: Success
+ *     - ESP_ERR_INVALID_STATE: Loopback transport not initialized
+ */
+esp_err_t sinricpro_loopback_get_handshake(const char **app_key, const char **device_ids);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SINRICPRO_TRANSPORT_H */
@@ -111,6 +111,7 @@ esp_err_t sinricpro_tv_on_power_state(
     void *user_data
 );
 
+#if CONFIG_SINRICPRO_CAPABILITY_VOLUME_CONTROLLER
 /**
  * @brief Register volume callback
  */
@@ -119,7 +120,9 @@ esp_err_t sinricpro_tv_on_volume(
     sinricpro_tv_volume_callback_t callback,
     void *user_data
 );
+#endif
 
+#if CONFIG_SINRICPRO_CAPABILITY_VOLUME_CONTROLLER
 /**
  * @brief Register adjust volume callback
  */
@@ -128,7 +131,9 @@ esp_err_t sinricpro_tv_on_adjust_volume(
     sinricpro_tv_adjust_volume_callback_t callback,
     void *user_data
 );
+#endif
 
+#if CONFIG_SINRICPRO_CAPABILITY_MUTE_CONTROLLER
 /**
  * @brief Register mute callback
  */
@@ -137,7 +142,9 @@ esp_err_t sinricpro_tv_on_mute(
     sinricpro_tv_mute_callback_t callback,
     void *user_data
 );
+#endif
 
+#if CONFIG_SINRICPRO_CAPABILITY_MEDIA_CONTROLLER
 /**
  * @brief Register media control callback
  */
@@ -146,7 +153,9 @@ esp_err_t sinricpro_tv_on_media_control(
     sinricpro_tv_media_control_callback_t callback,
     void *user_data
 );
+#endif
 
+#if CONFIG_SINRICPRO_CAPABILITY_INPUT_CONTROLLER
 /**
  * @brief Register input callback
  */
@@ -155,7 +164,9 @@ esp_err_t sinricpro_tv_on_input(
     sinricpro_tv_input_callback_t callback,
     void *user_data
 );
+#endif
 
+#if CONFIG_SINRICPRO_CAPABILITY_CHANNEL_CONTROLLER
 /**
  * @brief Register channel callback
  */
@@ -164,7 +175,9 @@ esp_err_t sinricpro_tv_on_channel(
     sinricpro_tv_channel_callback_t callback,
     void *user_data
 );
+#endif
 
+#if CONFIG_SINRICPRO_CAPABILITY_CHANNEL_CONTROLLER
 /**
  * @brief Register skip channels callback
  */
@@ -173,6 +186,7 @@ esp_err_t sinricpro_tv_on_skip_channels(
     sinricpro_tv_skip_channels_callback_t callback,
     void *user_data
 );
+#endif
 
 /**
  * @brief Send power state event
@@ -183,6 +197,7 @@ esp_err_t sinricpro_tv_send_power_state_event(
     const char *cause
 );
 
+#if CONFIG_SINRICPRO_CAPABILITY_VOLUME_CONTROLLER
 /**
  * @brief Send volume event
  */
@@ -191,7 +206,9 @@ esp_err_t sinricpro_tv_send_volume_event(
     int volume,
     const char *cause
 );
+#endif
 
+#if CONFIG_SINRICPRO_CAPABILITY_MUTE_CONTROLLER
 /**
  * @brief Send mute event
  */
@@ -200,7 +217,9 @@ esp_err_t sinricpro_tv_send_mute_event(
     bool mute,
     const char *cause
 );
+#endif
 
+#if CONFIG_SINRICPRO_CAPABILITY_MEDIA_CONTROLLER
 /**
  * @brief Send media control event
  */
@@ -209,7 +228,9 @@ esp_err_t sinricpro_tv_send_media_control_event(
     const char *control,
     const char *cause
 );
+#endif
 
+#if CONFIG_SINRICPRO_CAPABILITY_INPUT_CONTROLLER
 /**
  * @brief Send input event
  */
@@ -218,7 +239,9 @@ esp_err_t sinricpro_tv_send_input_event(
     const char *input,
     const char *cause
 );
+#endif
 
+#if CONFIG_SINRICPRO_CAPABILITY_CHANNEL_CONTROLLER
 /**
  * @brief Send channel event
  */
@@ -227,6 +250,7 @@ esp_err_t sinricpro_tv_send_channel_event(
     const sinricpro_tv_channel_t *channel,
     const char *cause
 );
+#endif
 
 #ifdef __cplusplus
 }
@@ -10,6 +10,7 @@
 #define SINRICPRO_WINDOWAC_H
 
 #include "sinricpro_types.h"
+#include "sinricpro_report.h"
 #include <stdbool.h>
 #include <stdint.h>
 
@@ -134,6 +135,7 @@ esp_err_t sinricpro_windowac_on_power_state(
     void *user_data
 );
 
+#if CONFIG_SINRICPRO_CAPABILITY_RANGE_CONTROLLER
 /**
  * @brief Register range value callback for fan speed
  *
@@ -147,7 +149,9 @@ esp_err_t sinricpro_windowac_on_range_value(
     sinricpro_windowac_range_value_callback_t callback,
     void *user_data
 );
+#endif
 
+#if CONFIG_SINRICPRO_CAPABILITY_RANGE_CONTROLLER
 /**
  * @brief Register adjust range value callback
  *
@@ -161,6 +165,7 @@ esp_err_t sinricpro_windowac_on_adjust_range_value(
     sinricpro_windowac_adjust_range_value_callback_t callback,
     void *user_data
 );
+#endif
 
 /**
  * @brief Register thermostat mode callback
@@ -218,6 +223,7 @@ esp_err_t sinricpro_windowac_send_power_state_event(
     const char *cause
 );
 
+#if CONFIG_SINRICPRO_CAPABILITY_RANGE_CONTROLLER
 /**
  * @brief Send range value event for fan speed
  *
@@ -231,6 +237,7 @@ esp_err_t sinricpro_windowac_send_range_value_event(
     int range_value,
     const char *cause
 );
+#endif
 
 /**
  * @brief Send thermostat mode event
@@ -260,6 +267,7 @@ esp_err_t sinricpro_windowac_send_target_temperature_event(
     const char *cause
 );
 
+#if CONFIG_SINRICPRO_CAPABILITY_TEMPERATURE_SENSOR
 /**
  * @brief Send current temperature and humidity event
  *
@@ -276,6 +284,35 @@ esp_err_t sinricpro_windowac_send_temperature_event(
     const char *cause
 );
 
+/**
+ * @brief Set the reporting policy of the current temperature
+ *
+ * @param[in] device Device handle
+ * @param[in] policy Reporting policy (see sinricpro_report.h)
+ * @return ESP_OK on success, error code otherwise
+ */
+esp_err_t sinricpro_windowac_set_temperature_report_policy(
+    sinricpro_device_handle_t device,
+    const sinricpro_report_policy_t *policy
+);
+
+/**
+ * @brief Push a temperature and humidity sample
+ *
+ * A currentTemperature event is sent when the reporting policy says so.
+ *
+ * @param[in] device Device handle
+ * @param[in] temperature Current temperature in Celsius
+ * @param[in] humidity Current humidity in percentage
+ * @return ESP_OK on success (sent or not due), ESP_ERR_INVALID_STATE without a policy
+ */
+esp_err_t sinricpro_windowac_push_temperature_sample(
+    sinricpro_device_handle_t device,
+    float temperature,
+    float humidity
+);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
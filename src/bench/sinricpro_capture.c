@@ -0,0 +1,493 @@
+/*
+ * Copyright (c) 2019-2025 Sinric. All rights reserved.
+ * Licensed under Creative Commons Attribution-Share Alike (CC BY-SA)
+ *
+ * This file is part of the SinricPro ESP-IDF component
+ * (https://github.com/sinricpro/esp-idf)
+ */
+
+#include "sinricpro_capture.h"
+#include "sinricpro_transport.h"
+#include "../core/sinricpro_capture_hook.h"
+#include <stdlib.h>
+#include <string.h>
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+
+static const char *TAG = "sinricpro_capture";
+
+#define REPLAY_EXPECTED_DEPTH   64
+#define REPLAY_DEFAULT_DRAIN_MS 2000
+#define REPLAY_MAX_FRAME        16384
+
+/* ========================================================================
+ * Capture
+ * ======================================================================== */
+
+/**
+ * @brief Capture state
+ */
+static struct {
+    sinricpro_capture_write_t writer;
+    void *context;
+    int64_t last_us;
+    volatile bool active;
+    SemaphoreHandle_t mutex;
+} capture_state = {0};
+
+static size_t encode_varint(uint64_t value, uint8_t *out)
+{
+    size_t n = 0;
+
+    do {
+        uint8_t byte = value & 0x7F;
+        value >>= 7;
+        out[n++] = byte | (value ? 0x80 : 0);
+    } while (value);
+
+    return n;
+}
+
+esp_err_t sinricpro_capture_start(sinricpro_capture_write_t writer, void *context)
+{
+    if (writer == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    if (capture_state.mutex == NULL) {
+        capture_state.mutex = xSemaphoreCreateMutex();
+        if (capture_state.mutex == NULL) {
+            return ESP_ERR_NO_MEM;
+        }
+    }
+
+    xSemaphoreTake(capture_state.mutex, portMAX_DELAY);
+
+    if (capture_state.active) {
+        xSemaphoreGive(capture_state.mutex);
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    const uint8_t header[8] = { 'S', 'P', 'C', 'P', SINRICPRO_CAPTURE_VERSION, 0, 0, 0 };
+    esp_err_t ret = writer(header, sizeof(header), context);
+    if (ret == ESP_OK) {
+        capture_state.writer = writer;
+        capture_state.context = context;
+        capture_state.last_us = esp_timer_get_time();
+        capture_state.active = true;
+    }
+
+    xSemaphoreGive(capture_state.mutex);
+
+    if (ret == ESP_OK) {
+        ESP_LOGI(TAG, "Capture started");
+    }
+
+    return ret;
+}
+
+esp_err_t sinricpro_capture_stop(void)
+{
+    if (capture_state.mutex == NULL) {
+        return ESP_OK;
+    }
+
+    xSemaphoreTake(capture_state.mutex, portMAX_DELAY);
+    bool was_active = capture_state.active;
+    capture_state.active = false;
+    capture_state.writer = NULL;
+    capture_state.context = NULL;
+    xSemaphoreGive(capture_state.mutex);
+
+    if (was_active) {
+        ESP_LOGI(TAG, "Capture stopped");
+    }
+
+    return ESP_OK;
+}
+
+bool sinricpro_capture_is_active(void)
+{
+    return capture_state.active;
+}
+
+void sinricpro_capture_record(sinricpro_capture_direction_t direction,
+                              const char *data,
+                              size_t length)
+{
+    if (!capture_state.active || data == NULL) {
+        return;
+    }
+
+    xSemaphoreTake(capture_state.mutex, portMAX_DELAY);
+
+    if (capture_state.active) {
+        int64_t now = esp_timer_get_time();
+        uint8_t prefix[1 + 10 + 10];
+        size_t n = 0;
+
+        prefix[n++] = (uint8_t)direction;
+        n += encode_varint((uint64_t)(now - capture_state.last_us), &prefix[n]);
+        n += encode_varint(length, &prefix[n]);
+        capture_state.last_us = now;
+
+        if (capture_state.writer(prefix, n, capture_state.context) != ESP_OK ||
+            capture_state.writer(data, length, capture_state.context) != ESP_OK) {
+            ESP_LOGW(TAG, "Capture writer failed, stopping capture");
+            capture_state.active = false;
+        }
+    }
+
+    xSemaphoreGive(capture_state.mutex);
+}
+
+/* ========================================================================
+ * Replay
+ * ======================================================================== */
+
+/**
+ * @brief Fingerprint of a response frame
+ */
+typedef struct {
+    uint32_t hash;
+} replay_print_t;
+
+/**
+ * @brief Replay state shared with the loopback sink
+ *
+ * Responses are produced asynchronously by the send task, so a response may
+ * reach the sink before the replay has read its recorded counterpart. The
+ * FIFO therefore holds either recorded fingerprints waiting for the core or
+ * produced fingerprints waiting for the log, never both.
+ */
+typedef struct {
+    sinricpro_replay_report_t *report;
+    replay_print_t pending[REPLAY_EXPECTED_DEPTH];
+    uint32_t head;
+    uint32_t count;
+    bool pending_produced;      /**< FIFO holds produced (not recorded) frames */
+    SemaphoreHandle_t mutex;
+    SemaphoreHandle_t consumed;
+} replay_run_t;
+
+static bool match_at(const char *data, size_t length, size_t pos, const char *token, size_t token_len)
+{
+    return pos + token_len <= length && memcmp(data + pos, token, token_len) == 0;
+}
+
+/**
+ * @brief FNV-1a over a frame, skipping the createdAt value and the HMAC
+ *
+ * createdAt is the timestamp of the most recent inbound frame at the moment
+ * the response is sent, which depends on task interleaving, and the HMAC
+ * covers it. Everything else in a response is deterministic.
+ */
+static uint32_t fingerprint(const char *data, size_t length)
+{
+    static const char created_at[] = "\"createdAt\":";
+    static const char hmac[] = "\"HMAC\":\"";
+    uint32_t hash = 2166136261u;
+    size_t i = 0;
+
+    while (i < length) {
+        bool skip_number = match_at(data, length, i, created_at, sizeof(created_at) - 1);
+        bool skip_string = match_at(data, length, i, hmac, sizeof(hmac) - 1);
+
+        if (skip_number || skip_string) {
+            i += skip_number ? sizeof(created_at) - 1 : sizeof(hmac) - 1;
+            while (i < length && (skip_number ? (data[i] != ',' && data[i] != '}')
+                                              : data[i] != '"')) {
+                i++;
+            }
+            continue;
+        }
+
+        hash ^= (uint8_t)data[i++];
+        hash *= 16777619u;
+    }
+
+    return hash;
+}
+
+static bool is_response(const char *data, size_t length)
+{
+    static const char marker[] = "\"type\":\"response\"";
+    const size_t marker_len = sizeof(marker) - 1;
+
+    for (size_t i = 0; i + marker_len <= length; i++) {
+        if (memcmp(data + i, marker, marker_len) == 0) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * @brief Match a fingerprint against the FIFO head, or queue it
+ *
+ * @return false if the FIFO is full and the fingerprint was not consumed
+ */
+static bool replay_match(replay_run_t *run, const char *data, size_t length, bool produced)
+{
+    replay_print_t print = { .hash = fingerprint(data, length) };
+    bool consumed = true;
+
+    xSemaphoreTake(run->mutex, portMAX_DELAY);
+
+    if (run->count > 0 && run->pending_produced != produced) {
+        replay_print_t *head = &run->pending[run->head];
+        if (head->hash == print.hash) {
+            run->report->matched_responses++;
+        } else {
+            run->report->mismatched_responses++;
+        }
+        run->head = (run->head + 1) % REPLAY_EXPECTED_DEPTH;
+        run->count--;
+    } else if (run->count < REPLAY_EXPECTED_DEPTH) {
+        uint32_t tail = (run->head + run->count) % REPLAY_EXPECTED_DEPTH;
+        run->pending[tail] = print;
+        run->pending_produced = produced;
+        run->count++;
+    } else {
+        consumed = false;
+    }
+
+    xSemaphoreGive(run->mutex);
+
+    if (consumed && produced) {
+        xSemaphoreGive(run->consumed);
+    }
+
+    return consumed;
+}
+
+static void replay_sink(const char *data, size_t length, void *context)
+{
+    replay_run_t *run = (replay_run_t *)context;
+
+    if (!is_response(data, length)) {
+        /* Events raised by callbacks during replay are not part of the comparison */
+        return;
+    }
+
+    if (!replay_match(run, data, length, true)) {
+        xSemaphoreTake(run->mutex, portMAX_DELAY);
+        run->report->unexpected_frames++;
+        xSemaphoreGive(run->mutex);
+    }
+}
+
+static esp_err_t read_varint(sinricpro_capture_read_t reader, void *context, uint64_t *value)
+{
+    uint64_t result = 0;
+
+    for (int shift = 0; shift < 64; shift += 7) {
+        uint8_t byte;
+        esp_err_t ret = reader(&byte, 1, context);
+        if (ret != ESP_OK) {
+            return ret;
+        }
+        result |= (uint64_t)(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0) {
+            *value = result;
+            return ESP_OK;
+        }
+    }
+
+    return ESP_ERR_INVALID_SIZE;
+}
+
+/**
+ * @brief Queue or match a recorded response, waiting while the FIFO is full
+ */
+static void replay_expect(replay_run_t *run, const char *data, size_t length)
+{
+    while (!replay_match(run, data, length, false)) {
+        xSemaphoreTake(run->consumed, pdMS_TO_TICKS(100));
+    }
+}
+
+/**
+ * @brief Wait until the core produced every recorded response read so far
+ *
+ * @return true if nothing is outstanding, false on timeout
+ */
+static bool replay_wait_recorded(replay_run_t *run, uint32_t timeout_ms)
+{
+    int64_t deadline = esp_timer_get_time() + (int64_t)timeout_ms * 1000;
+
+    for (;;) {
+        xSemaphoreTake(run->mutex, portMAX_DELAY);
+        uint32_t outstanding = run->pending_produced ? 0 : run->count;
+        xSemaphoreGive(run->mutex);
+
+        if (outstanding == 0) {
+            return true;
+        }
+        if (esp_timer_get_time() >= deadline) {
+            return false;
+        }
+        xSemaphoreTake(run->consumed, pdMS_TO_TICKS(10) + 1);
+    }
+}
+
+esp_err_t sinricpro_replay_run(sinricpro_capture_read_t reader,
+                                void *context,
+                                const sinricpro_replay_config_t *config,
+                                sinricpro_replay_report_t *report)
+{
+    if (reader == NULL || report == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    memset(report, 0, sizeof(sinricpro_replay_report_t));
+
+    uint8_t header[8];
+    esp_err_t ret = reader(header, sizeof(header), context);
+    if (ret != ESP_OK || memcmp(header, SINRICPRO_CAPTURE_MAGIC, 4) != 0 ||
+        header[4] != SINRICPRO_CAPTURE_VERSION) {
+        ESP_LOGE(TAG, "Not a capture log (or unsupported version)");
+        return ESP_ERR_INVALID_VERSION;
+    }
+
+    replay_run_t *run = calloc(1, sizeof(replay_run_t));
+    if (run == NULL) {
+        return ESP_ERR_NO_MEM;
+    }
+
+    run->report = report;
+    run->mutex = xSemaphoreCreateMutex();
+    run->consumed = xSemaphoreCreateBinary();
+    if (run->mutex == NULL || run->consumed == NULL) {
+        ret = ESP_ERR_NO_MEM;
+        goto cleanup;
+    }
+
+    bool pacing = config ? config->original_pacing : false;
+    uint32_t drain_ms = (config && config->drain_timeout_ms) ? config->drain_timeout_ms
+                                                             : REPLAY_DEFAULT_DRAIN_MS;
+
+    sinricpro_loopback_set_sink(replay_sink, run);
+
+    int64_t start = esp_timer_get_time();
+    int64_t recorded_us = 0;
+    char *frame = NULL;
+
+    for (;;) {
+        uint8_t direction;
+        uint64_t delta_us = 0;
+        uint64_t length = 0;
+
+        ret = reader(&direction, 1, context);
+        if (ret == ESP_ERR_NOT_FOUND) {
+            ret = ESP_OK;
+            break;
+        }
+        if (ret == ESP_OK) {
+            ret = read_varint(reader, context, &delta_us);
+        }
+        if (ret == ESP_OK) {
+            ret = read_varint(reader, context, &length);
+        }
+        if (ret == ESP_OK && length > REPLAY_MAX_FRAME) {
+            ret = ESP_ERR_INVALID_SIZE;
+        }
+        if (ret != ESP_OK) {
+            ESP_LOGE(TAG, "Truncated or corrupt capture: %s", esp_err_to_name(ret));
+            break;
+        }
+
+        frame = malloc(length + 1);
+        if (frame == NULL) {
+            ret = ESP_ERR_NO_MEM;
+            break;
+        }
+
+        ret = (length > 0) ? reader(frame, length, context) : ESP_OK;
+        if (ret != ESP_OK) {
+            ESP_LOGE(TAG, "Truncated capture");
+            break;
+        }
+        frame[length] = '\0';
+
+        recorded_us += delta_us;
+
+        if (direction == SINRICPRO_CAPTURE_INBOUND) {
+            /*
+             * Keep the recorded causality: responses that preceded this frame
+             * in the capture must have been produced before it is injected.
+             * This also keeps a fast replay from overrunning the send queue.
+             */
+            if (!replay_wait_recorded(run, drain_ms)) {
+                ESP_LOGW(TAG, "Response overdue before inbound frame %lu",
+                         (unsigned long)report->inbound_frames);
+            }
+
+            if (pacing) {
+                int64_t ahead_ms = (start + recorded_us - esp_timer_get_time()) / 1000;
+                if (ahead_ms > 0) {
+                    vTaskDelay(pdMS_TO_TICKS(ahead_ms) + 1);
+                }
+            }
+
+            ret = sinricpro_loopback_inject(frame, length);
+            if (ret != ESP_OK) {
+                ESP_LOGE(TAG, "Loopback transport not active: %s", esp_err_to_name(ret));
+                break;
+            }
+            report->inbound_frames++;
+        } else if (is_response(frame, length)) {
+            report->expected_responses++;
+            replay_expect(run, frame, length);
+        } else {
+            report->skipped_events++;
+        }
+
+        free(frame);
+        frame = NULL;
+    }
+
+    free(frame);
+
+    /* Wait for the core to emit the remaining responses */
+    replay_wait_recorded(run, drain_ms);
+
+    report->elapsed_us = (uint64_t)(esp_timer_get_time() - start);
+
+    sinricpro_loopback_set_sink(NULL, NULL);
+
+    xSemaphoreTake(run->mutex, portMAX_DELAY);
+    if (run->pending_produced) {
+        report->unexpected_frames += run->count;
+    } else {
+        report->missing_responses = run->count;
+    }
+    xSemaphoreGive(run->mutex);
+
+    if (report->elapsed_us > 0) {
+        report->frames_per_second = (float)report->inbound_frames * 1000000.0f /
+                                    (float)report->elapsed_us;
+    }
+
+    ESP_LOGI(TAG, "Replay: %lu inbound frames in %llu ms (%.1f/s), responses %lu/%lu matched",
+             (unsigned long)report->inbound_frames,
+             (unsigned long long)(report->elapsed_us / 1000),
+             report->frames_per_second,
+             (unsigned long)report->matched_responses,
+             (unsigned long)report->expected_responses);
+
+cleanup:
+    if (run->consumed) {
+        vSemaphoreDelete(run->consumed);
+    }
+    if (run->mutex) {
+        vSemaphoreDelete(run->mutex);
+    }
+    free(run);
+
+    return ret;
+}
@@ -0,0 +1,514 @@
+/*
+ * Copyright (c) 2019-2025 Sinric. All rights reserved.
+ * Licensed under Creative Commons Attribution-Share Alike (CC BY-SA)
+ *
+ * This file is part of the SinricPro ESP-IDF component
+ * (https://github.com/sinricpro/esp-idf)
+ */
+
+#include "sinricpro_loadgen.h"
+#include "sinricpro_transport.h"
+#include "../core/sinricpro_signature.h"
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "cJSON.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+
+static const char *TAG = "sinricpro_loadgen";
+
+#define LOADGEN_FRAME_SIZE      1024
+#define LOADGEN_DEFAULT_TIMEOUT 5000
+#define LOADGEN_DEFAULT_SEED    0x5EED1234u
+#define LOADGEN_TIMESTAMP       1700000000u
+
+/**
+ * @brief Built-in request mix: every action the capabilities handle
+ */
+static const sinricpro_loadgen_mix_entry_t default_mix[] = {
+    { "setPowerState",            "{\"state\":\"On\"}",                                  1 },
+    { "setPowerState",            "{\"state\":\"Off\"}",                                 1 },
+    { "setBrightness",            "{\"brightness\":75}",                                 1 },
+    { "adjustBrightness",         "{\"brightnessDelta\":-10}",                           1 },
+    { "setColor",                 "{\"color\":{\"r\":255,\"g\":128,\"b\":0}}",           1 },
+    { "setColorTemperature",      "{\"colorTemperature\":4000}",                         1 },
+    { "increaseColorTemperature", "{}",                                                  1 },
+    { "decreaseColorTemperature", "{}",                                                  1 },
+    { "setPowerLevel",            "{\"powerLevel\":50}",                                 1 },
+    { "adjustPowerLevel",         "{\"powerLevelDelta\":5}",                             1 },
+    { "setRangeValue",            "{\"rangeValue\":3}",                                  1 },
+    { "adjustRangeValue",         "{\"rangeValueDelta\":1}",                             1 },
+    { "targetTemperature",        "{\"temperature\":22.5}",                              1 },
+    { "adjustTargetTemperature",  "{\"temperature\":1}",                                 1 },
+    { "setThermostatMode",        "{\"thermostatMode\":\"COOL\"}",                       1 },
+    { "setVolume",                "{\"volume\":40}",                                     1 },
+    { "adjustVolume",             "{\"volume\":-5}",                                     1 },
+    { "setMute",                  "{\"mute\":true}",                                     1 },
+    { "mediaControl",             "{\"control\":\"Play\"}",                              1 },
+    { "selectInput",              "{\"input\":\"HDMI1\"}",                               1 },
+    { "changeChannel",            "{\"channel\":{\"name\":\"HBO\"}}",                    1 },
+    { "skipChannels",             "{\"channelCount\":1}",                                1 },
+    { "setEqualizerBands",        "{\"bands\":[{\"name\":\"BASS\",\"level\":2}]}",       1 },
+    { "setMode",                  "{\"mode\":\"Open\"}",                                 1 },
+    { "setLockState",             "{\"state\":\"lock\"}",                                1 },
+    { "setSetting",               "{\"setting\":\"id\",\"value\":1}",                    1 },
+};
+
+/**
+ * @brief Outstanding request slot
+ */
+typedef struct {
+    uint32_t seq;
+    int64_t sent_at;
+    bool active;
+} loadgen_slot_t;
+
+/**
+ * @brief Run state shared with the loopback sink
+ */
+typedef struct {
+    const sinricpro_loadgen_config_t *config;
+    sinricpro_loadgen_report_t *report;
+    loadgen_slot_t *slots;
+    uint32_t slot_count;
+    uint32_t *latencies;
+    uint32_t latency_count;
+    SemaphoreHandle_t mutex;
+    SemaphoreHandle_t capacity;
+} loadgen_run_t;
+
+static uint32_t loadgen_rand(uint32_t *state)
+{
+    /* xorshift32: deterministic for a given seed */
+    uint32_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *state = x;
+    return x;
+}
+
+static const sinricpro_loadgen_mix_entry_t *loadgen_pick(const sinricpro_loadgen_mix_entry_t *mix,
+                                                          size_t mix_count,
+                                                          uint32_t total_weight,
+                                                          uint32_t *rng)
+{
+    uint32_t r = loadgen_rand(rng) % total_weight;
+
+    for (size_t i = 0; i < mix_count; i++) {
+        if (r < mix[i].weight) {
+            return &mix[i];
+        }
+        r -= mix[i].weight;
+    }
+
+    return &mix[mix_count - 1];
+}
+
+static const char *loadgen_default_value(const char *action)
+{
+    for (size_t i = 0; i < sizeof(default_mix) / sizeof(default_mix[0]); i++) {
+        if (strcmp(default_mix[i].action, action) == 0) {
+            return default_mix[i].value_json;
+        }
+    }
+
+    return "{}";
+}
+
+/**
+ * @brief Loopback sink: everything the SDK sends arrives here
+ */
+static void loadgen_sink(const char *data, size_t length, void *context)
+{
+    loadgen_run_t *run = (loadgen_run_t *)context;
+    int64_t now = esp_timer_get_time();
+
+    cJSON *json = cJSON_Parse(data);
+    if (json == NULL) {
+        xSemaphoreTake(run->mutex, portMAX_DELAY);
+        run->report->unmatched_frames++;
+        xSemaphoreGive(run->mutex);
+        return;
+    }
+
+    /* Verify the SDK's signature over the raw payload text */
+    bool signature_ok = false;
+    cJSON *signature = cJSON_GetObjectItem(json, "signature");
+    cJSON *hmac = signature ? cJSON_GetObjectItem(signature, "HMAC") : NULL;
+    if (hmac && cJSON_IsString(hmac)) {
+        char *payload_str = malloc(length + 1);
+        if (payload_str &&
+            sinricpro_extract_payload(data, payload_str, length + 1) == ESP_OK &&
+            sinricpro_verify_signature(run->config->app_secret, payload_str,
+                                       hmac->valuestring) == ESP_OK) {
+            signature_ok = true;
+        }
+        free(payload_str);
+    }
+
+    cJSON *payload = cJSON_GetObjectItem(json, "payload");
+    cJSON *type = payload ? cJSON_GetObjectItem(payload, "type") : NULL;
+    cJSON *token = payload ? cJSON_GetObjectItem(payload, "replyToken") : NULL;
+    cJSON *success = payload ? cJSON_GetObjectItem(payload, "success") : NULL;
+
+    xSemaphoreTake(run->mutex, portMAX_DELAY);
+
+    if (!signature_ok) {
+        run->report->signature_failures++;
+    }
+
+    bool released = false;
+
+    if (type && cJSON_IsString(type) && strcmp(type->valuestring, "event") == 0) {
+        run->report->events_received++;
+    } else if (type && cJSON_IsString(type) && strcmp(type->valuestring, "response") == 0 &&
+               token && cJSON_IsString(token) && strncmp(token->valuestring, "lg-", 3) == 0) {
+        uint32_t seq = (uint32_t)strtoul(token->valuestring + 3, NULL, 10);
+        loadgen_slot_t *slot = NULL;
+
+        for (uint32_t i = 0; i < run->slot_count; i++) {
+            if (run->slots[i].active && run->slots[i].seq == seq) {
+                slot = &run->slots[i];
+                break;
+            }
+        }
+
+        if (slot) {
+            slot->active = false;
+            run->report->responses_received++;
+            if (success && cJSON_IsTrue(success)) {
+                run->report->responses_succeeded++;
+            }
+            if (run->latency_count < run->config->request_count) {
+                run->latencies[run->latency_count++] = (uint32_t)(now - slot->sent_at);
+            }
+            released = true;
+        } else {
+            run->report->unmatched_frames++;
+        }
+    } else {
+        run->report->unmatched_frames++;
+    }
+
+    xSemaphoreGive(run->mutex);
+
+    if (released) {
+        xSemaphoreGive(run->capacity);
+    }
+
+    cJSON_Delete(json);
+}
+
+/**
+ * @brief Reclaim the oldest outstanding slot as timed out
+ *
+ * @return true if a slot was reclaimed
+ */
+static bool loadgen_expire_oldest(loadgen_run_t *run)
+{
+    loadgen_slot_t *oldest = NULL;
+
+    xSemaphoreTake(run->mutex, portMAX_DELAY);
+    for (uint32_t i = 0; i < run->slot_count; i++) {
+        if (run->slots[i].active && (oldest == NULL || run->slots[i].sent_at < oldest->sent_at)) {
+            oldest = &run->slots[i];
+        }
+    }
+    if (oldest) {
+        oldest->active = false;
+        run->report->timeouts++;
+    }
+    xSemaphoreGive(run->mutex);
+
+    return oldest != NULL;
+}
+
+static esp_err_t loadgen_inject_request(loadgen_run_t *run,
+                                         uint32_t seq,
+                                         const char *device_id,
+                                         const sinricpro_loadgen_mix_entry_t *entry,
+                                         char *payload,
+                                         char *frame)
+{
+    const char *value = entry->value_json ? entry->value_json : loadgen_default_value(entry->action);
+
+    int len = snprintf(payload, LOADGEN_FRAME_SIZE,
+                       "{\"action\":\"%s\",\"clientId\":\"loadgen\",\"createdAt\":%lu,"
+                       "\"deviceId\":\"%s\",\"replyToken\":\"lg-%lu\",\"type\":\"request\","
+                       "\"value\":%s}",
+                       entry->action, (unsigned long)(LOADGEN_TIMESTAMP + seq), device_id,
+                       (unsigned long)seq, value);
+    if (len < 0 || len >= LOADGEN_FRAME_SIZE) {
+        return ESP_ERR_INVALID_SIZE;
+    }
+
+    char signature[64];
+    esp_err_t ret = sinricpro_calculate_signature(run->config->app_secret, payload,
+                                                  signature, sizeof(signature));
+    if (ret != ESP_OK) {
+        return ret;
+    }
+
+    len = snprintf(frame, LOADGEN_FRAME_SIZE,
+                   "{\"header\":{\"payloadVersion\":2,\"signatureVersion\":1},"
+                   "\"payload\":%s,\"signature\":{\"HMAC\":\"%s\"}}",
+                   payload, signature);
+    if (len < 0 || len >= LOADGEN_FRAME_SIZE) {
+        return ESP_ERR_INVALID_SIZE;
+    }
+
+    return sinricpro_loopback_inject(frame, (size_t)len);
+}
+
+/**
+ * @brief Check the appkey/deviceids handshake the SDK announced
+ */
+static bool loadgen_check_handshake(const sinricpro_loadgen_config_t *config)
+{
+    const char *app_key = NULL;
+    const char *device_ids = NULL;
+
+    if (sinricpro_loopback_get_handshake(&app_key, &device_ids) != ESP_OK) {
+        return false;
+    }
+
+    if (app_key == NULL || strcmp(app_key, config->app_key) != 0) {
+        ESP_LOGW(TAG, "appkey mismatch");
+        return false;
+    }
+
+    for (size_t i = 0; i < config->device_count; i++) {
+        const char *id = config->device_ids[i];
+        size_t id_len = strlen(id);
+        const char *p = device_ids;
+        bool found = false;
+
+        while (p && *p) {
+            const char *end = strchr(p, ';');
+            size_t len = end ? (size_t)(end - p) : strlen(p);
+            if (len == id_len && strncmp(p, id, id_len) == 0) {
+                found = true;
+                break;
+            }
+            p = end ? end + 1 : NULL;
+        }
+
+        if (!found) {
+            ESP_LOGW(TAG, "deviceids does not announce %s", id);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static int compare_u32(const void *a, const void *b)
+{
+    uint32_t x = *(const uint32_t *)a;
+    uint32_t y = *(const uint32_t *)b;
+    return (x > y) - (x < y);
+}
+
+static uint32_t percentile(const uint32_t *sorted, uint32_t count, uint32_t pct)
+{
+    if (count == 0) {
+        return 0;
+    }
+
+    uint32_t index = (uint32_t)(((uint64_t)count * pct + 99) / 100);
+    return sorted[index > 0 ? index - 1 : 0];
+}
+
+esp_err_t sinricpro_loadgen_run(const sinricpro_loadgen_config_t *config,
+                                 sinricpro_loadgen_report_t *report)
+{
+    if (config == NULL || report == NULL || config->app_key == NULL ||
+        config->app_secret == NULL || config->device_ids == NULL ||
+        config->device_count == 0 || config->request_count == 0) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    const sinricpro_loadgen_mix_entry_t *mix = config->mix;
+    size_t mix_count = config->mix_count;
+    if (mix == NULL || mix_count == 0) {
+        mix = default_mix;
+        mix_count = sizeof(default_mix) / sizeof(default_mix[0]);
+    }
+
+    uint32_t total_weight = 0;
+    for (size_t i = 0; i < mix_count; i++) {
+        total_weight += mix[i].weight;
+    }
+    if (total_weight == 0) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    memset(report, 0, sizeof(sinricpro_loadgen_report_t));
+
+    loadgen_run_t run = {
+        .config = config,
+        .report = report,
+        .slot_count = config->max_in_flight ? config->max_in_flight : 1,
+    };
+
+    uint32_t timeout_ms = config->response_timeout_ms ? config->response_timeout_ms
+                                                      : LOADGEN_DEFAULT_TIMEOUT;
+
+    run.slots = calloc(run.slot_count, sizeof(loadgen_slot_t));
+    run.latencies = calloc(config->request_count, sizeof(uint32_t));
+    run.mutex = xSemaphoreCreateMutex();
+    run.capacity = xSemaphoreCreateCounting(run.slot_count, run.slot_count);
+    char *payload = malloc(LOADGEN_FRAME_SIZE);
+    char *frame = malloc(LOADGEN_FRAME_SIZE);
+
+    esp_err_t ret = ESP_OK;
+
+    if (run.slots == NULL || run.latencies == NULL || run.mutex == NULL ||
+        run.capacity == NULL || payload == NULL || frame == NULL) {
+        ret = ESP_ERR_NO_MEM;
+        goto cleanup;
+    }
+
+    report->handshake_ok = loadgen_check_handshake(config);
+
+    sinricpro_loopback_set_sink(loadgen_sink, &run);
+
+    /* Timestamp message, as the server sends right after connecting */
+    snprintf(frame, LOADGEN_FRAME_SIZE, "{\"timestamp\":%lu}", (unsigned long)LOADGEN_TIMESTAMP);
+    ret = sinricpro_loopback_inject(frame, 0);
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "Loopback transport not active: %s", esp_err_to_name(ret));
+        goto detach;
+    }
+
+    ESP_LOGI(TAG, "Running %lu requests across %zu devices (%zu mix entries)",
+             (unsigned long)config->request_count, config->device_count, mix_count);
+
+    uint32_t rng = config->seed ? config->seed : LOADGEN_DEFAULT_SEED;
+    int64_t start = esp_timer_get_time();
+
+    for (uint32_t seq = 0; seq < config->request_count; seq++) {
+        /* Pace to the offered load */
+        if (config->requests_per_second > 0) {
+            int64_t due = start + ((int64_t)seq * 1000000) / config->requests_per_second;
+            int64_t ahead_ms = (due - esp_timer_get_time()) / 1000;
+            if (ahead_ms > 0) {
+                vTaskDelay(pdMS_TO_TICKS(ahead_ms) > 0 ? pdMS_TO_TICKS(ahead_ms) : 1);
+            }
+        }
+
+        /* Wait for an in-flight slot, expiring the oldest request on timeout */
+        while (xSemaphoreTake(run.capacity, pdMS_TO_TICKS(timeout_ms)) != pdTRUE) {
+            if (!loadgen_expire_oldest(&run)) {
+                break;
+            }
+            xSemaphoreGive(run.capacity);
+        }
+
+        const sinricpro_loadgen_mix_entry_t *entry = loadgen_pick(mix, mix_count, total_weight, &rng);
+        const char *device_id = config->device_ids[loadgen_rand(&rng) % config->device_count];
+
+        xSemaphoreTake(run.mutex, portMAX_DELAY);
+        loadgen_slot_t *slot = NULL;
+        for (uint32_t i = 0; i < run.slot_count; i++) {
+            if (!run.slots[i].active) {
+                slot = &run.slots[i];
+                break;
+            }
+        }
+        if (slot) {
+            slot->seq = seq;
+            slot->sent_at = esp_timer_get_time();
+            slot->active = true;
+        }
+        xSemaphoreGive(run.mutex);
+
+        if (slot == NULL) {
+            /* Cannot happen while capacity tracks the slots */
+            xSemaphoreGive(run.capacity);
+            continue;
+        }
+
+        ret = loadgen_inject_request(&run, seq, device_id, entry, payload, frame);
+        if (ret != ESP_OK) {
+            ESP_LOGE(TAG, "Failed to inject request %lu: %s",
+                     (unsigned long)seq, esp_err_to_name(ret));
+            xSemaphoreTake(run.mutex, portMAX_DELAY);
+            slot->active = false;
+            xSemaphoreGive(run.mutex);
+            xSemaphoreGive(run.capacity);
+            goto detach;
+        }
+
+        report->requests_sent++;
+    }
+
+    /* Drain: wait until every slot is back or timed out */
+    for (uint32_t i = 0; i < run.slot_count; i++) {
+        while (xSemaphoreTake(run.capacity, pdMS_TO_TICKS(timeout_ms)) != pdTRUE) {
+            if (!loadgen_expire_oldest(&run)) {
+                break;
+            }
+            xSemaphoreGive(run.capacity);
+        }
+    }
+
+    report->elapsed_us = (uint64_t)(esp_timer_get_time() - start);
+
+detach:
+    sinricpro_loopback_set_sink(NULL, NULL);
+
+    if (report->elapsed_us > 0) {
+        report->requests_per_second = (float)report->responses_received * 1000000.0f /
+                                      (float)report->elapsed_us;
+    }
+
+    if (run.latency_count > 0) {
+        qsort(run.latencies, run.latency_count, sizeof(uint32_t), compare_u32);
+        report->latency_min_us = run.latencies[0];
+        report->latency_p50_us = percentile(run.latencies, run.latency_count, 50);
+        report->latency_p90_us = percentile(run.latencies, run.latency_count, 90);
+        report->latency_p99_us = percentile(run.latencies, run.latency_count, 99);
+        report->latency_max_us = run.latencies[run.latency_count - 1];
+    }
+
+cleanup:
+    free(frame);
+    free(payload);
+    if (run.capacity) {
+        vSemaphoreDelete(run.capacity);
+    }
+    if (run.mutex) {
+        vSemaphoreDelete(run.mutex);
+    }
+    free(run.latencies);
+    free(run.slots);
+
+    return ret;
+}
+
+void sinricpro_loadgen_log_report(const sinricpro_loadgen_report_t *report)
+{
+    if (report == NULL) {
+        return;
+    }
+
+    ESP_LOGI(TAG, "Handshake: %s", report->handshake_ok ? "OK" : "MISMATCH");
+    ESP_LOGI(TAG, "Requests: sent=%lu, responses=%lu, succeeded=%lu, timeouts=%lu",
+             (unsigned long)report->requests_sent, (unsigned long)report->responses_received,
+             (unsigned long)report->responses_succeeded, (unsigned long)report->timeouts);
+    ESP_LOGI(TAG, "Frames: events=%lu, bad signatures=%lu, unmatched=%lu",
+             (unsigned long)report->events_received, (unsigned long)report->signature_failures,
+             (unsigned long)report->unmatched_frames);
+    ESP_LOGI(TAG, "Throughput: %.1f req/s over %llu ms",
+             report->requests_per_second, (unsigned long long)(report->elapsed_us / 1000));
+    ESP_LOGI(TAG, "Latency (us): min=%lu p50=%lu p90=%lu p99=%lu max=%lu",
+             (unsigned long)report->latency_min_us, (unsigned long)report->latency_p50_us,
+             (unsigned long)report->latency_p90_us, (unsigned long)report->latency_p99_us,
+             (unsigned long)report->latency_max_us);
+}
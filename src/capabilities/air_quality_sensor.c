@@ -8,10 +8,13 @@
 
 #include "air_quality_sensor.h"
 #include "../core/sinricpro_device_internal.h"
+#include "../core/sinricpro_alloc.h"
 #include "../core/sinricpro_event_limiter.h"
+#include "../core/sinricpro_report_engine.h"
 #include "sinricpro_types.h"
 #include <stdlib.h>
 #include <string.h>
+#include <math.h>
 #include "esp_log.h"
 #include "cJSON.h"
 
@@ -19,12 +22,13 @@ static const char *TAG = "airquality_sensor";
 
 struct sinricpro_air_quality_sensor {
     sinricpro_event_limiter_handle_t limiter;
+    sinricpro_report_handle_t report;   /* Created with the first policy */
 };
 
 sinricpro_air_quality_sensor_handle_t sinricpro_air_quality_sensor_capability_create(void)
 {
     sinricpro_air_quality_sensor_handle_t handle =
-        malloc(sizeof(struct sinricpro_air_quality_sensor));
+        sinricpro_object_alloc(sizeof(struct sinricpro_air_quality_sensor));
 
     if (handle == NULL) {
         ESP_LOGE(TAG, "Failed to allocate AirQualitySensor");
@@ -32,9 +36,10 @@ sinricpro_air_quality_sensor_handle_t sinricpro_air_quality_sensor_capability_cr
     }
 
     handle->limiter = sinricpro_event_limiter_create(SINRICPRO_EVENT_LIMIT_SENSOR);
+    handle->report = NULL;
     if (handle->limiter == NULL) {
         ESP_LOGE(TAG, "Failed to create event limiter");
-        free(handle);
+        sinricpro_object_free(handle);
         return NULL;
     }
 
@@ -54,12 +59,6 @@ esp_err_t sinricpro_air_quality_sensor_send_event(
         return ESP_ERR_INVALID_ARG;
     }
 
-    if (!sinricpro_event_limiter_check(handle->limiter)) {
-        uint32_t wait_ms = sinricpro_event_limiter_time_until_next(handle->limiter);
-        ESP_LOGW(TAG, "Air quality event rate limited (wait %lu ms)", wait_ms);
-        return SINRICPRO_ERR_RATE_LIMITED;
-    }
-
     ESP_LOGI(TAG, "Sending air quality event: device=%s, PM1=%d, PM2.5=%d, PM10=%d",
              device_id, pm1, pm2_5, pm10);
 
@@ -68,18 +67,68 @@ esp_err_t sinricpro_air_quality_sensor_send_event(
     cJSON_AddNumberToObject(value, "pm2_5", pm2_5);
     cJSON_AddNumberToObject(value, "pm10", pm10);
 
-    esp_err_t ret = sinricpro_core_send_event(device_id, "airQuality", cause, value);
-    if (ret != ESP_OK) {
+    esp_err_t ret = sinricpro_core_send_event(device_id, "airQuality",
+                                              cause, value, handle->limiter);
+    if (ret != ESP_OK && ret != SINRICPRO_ERR_RATE_LIMITED) {
         ESP_LOGE(TAG, "Failed to send air quality event: %s", esp_err_to_name(ret));
     }
 
     return ret;
 }
 
+esp_err_t sinricpro_air_quality_sensor_capability_set_report_policy(
+    sinricpro_air_quality_sensor_handle_t handle,
+    const sinricpro_report_policy_t *policy)
+{
+    if (handle == NULL || policy == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    return sinricpro_report_configure(&handle->report, 3, policy, SINRICPRO_EVENT_LIMIT_SENSOR);
+}
+
+esp_err_t sinricpro_air_quality_sensor_capability_push_sample(
+    sinricpro_air_quality_sensor_handle_t handle,
+    const char *device_id,
+    int pm1,
+    int pm2_5,
+    int pm10)
+{
+    if (handle == NULL || device_id == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    if (handle->report == NULL) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    const float samples[3] = { pm1, pm2_5, pm10 };
+    float values[3];
+
+    sinricpro_report_due_t due = sinricpro_report_push(handle->report, samples, values);
+    if (due == SINRICPRO_REPORT_NOT_DUE) {
+        return ESP_OK;
+    }
+
+    if (due == SINRICPRO_REPORT_HEARTBEAT) {
+        sinricpro_core_forget_state(device_id, "airQuality");
+    }
+
+    esp_err_t ret = sinricpro_air_quality_sensor_send_event(handle, device_id,
+                                                            (int)lroundf(values[0]),
+                                                            (int)lroundf(values[1]),
+                                                            (int)lroundf(values[2]),
+                                                            SINRICPRO_CAUSE_PERIODIC_POLL);
+    sinricpro_report_done(handle->report, values, ret == ESP_OK);
+
+    return ret;
+}
+
 void sinricpro_air_quality_sensor_destroy(sinricpro_air_quality_sensor_handle_t handle)
 {
     if (handle == NULL) return;
     if (handle->limiter) sinricpro_event_limiter_destroy(handle->limiter);
-    free(handle);
+    sinricpro_report_destroy(handle->report);
+    sinricpro_object_free(handle);
     ESP_LOGD(TAG, "AirQualitySensor destroyed");
 }
@@ -10,6 +10,7 @@
 #define AIR_QUALITY_SENSOR_H
 
 #include "sinricpro_types.h"
+#include "sinricpro_report.h"
 #include <stdint.h>
 
 #ifdef __cplusplus
@@ -28,6 +29,17 @@ esp_err_t sinricpro_air_quality_sensor_send_event(
     int pm10,
     const char *cause);
 
+esp_err_t sinricpro_air_quality_sensor_capability_set_report_policy(
+    sinricpro_air_quality_sensor_handle_t handle,
+    const sinricpro_report_policy_t *policy);
+
+esp_err_t sinricpro_air_quality_sensor_capability_push_sample(
+    sinricpro_air_quality_sensor_handle_t handle,
+    const char *device_id,
+    int pm1,
+    int pm2_5,
+    int pm10);
+
 void sinricpro_air_quality_sensor_destroy(sinricpro_air_quality_sensor_handle_t handle);
 
 #ifdef __cplusplus
@@ -8,6 +8,7 @@
 
 #include "channel_controller.h"
 #include "../core/sinricpro_device_internal.h"
+#include "../core/sinricpro_alloc.h"
 #include "../core/sinricpro_event_limiter.h"
 #include "sinricpro_types.h"
 #include <stdlib.h>
@@ -28,7 +29,7 @@ struct sinricpro_channel_controller {
 sinricpro_channel_controller_handle_t sinricpro_channel_controller_create(void)
 {
     sinricpro_channel_controller_handle_t handle =
-        malloc(sizeof(struct sinricpro_channel_controller));
+        sinricpro_object_alloc(sizeof(struct sinricpro_channel_controller));
 
     if (handle == NULL) {
         ESP_LOGE(TAG, "Failed to allocate ChannelController");
@@ -43,7 +44,7 @@ sinricpro_channel_controller_handle_t sinricpro_channel_controller_create(void)
 
     if (handle->limiter == NULL) {
         ESP_LOGE(TAG, "Failed to create event limiter");
-        free(handle);
+        sinricpro_object_free(handle);
         return NULL;
     }
 
@@ -158,12 +159,6 @@ esp_err_t sinricpro_channel_controller_send_event(
         return ESP_ERR_INVALID_ARG;
     }
 
-    if (!sinricpro_event_limiter_check(handle->limiter)) {
-        uint32_t wait_ms = sinricpro_event_limiter_time_until_next(handle->limiter);
-        ESP_LOGW(TAG, "Channel event rate limited (wait %lu ms)", wait_ms);
-        return SINRICPRO_ERR_RATE_LIMITED;
-    }
-
     ESP_LOGI(TAG, "Sending channel event: device=%s, number=%d, name=%s, cause=%s",
              device_id, channel->number, channel->name ? channel->name : "", cause);
 
@@ -175,8 +170,9 @@ esp_err_t sinricpro_channel_controller_send_event(
     }
     cJSON_AddItemToObject(value, "channel", channel_obj);
 
-    esp_err_t ret = sinricpro_core_send_event(device_id, "changeChannel", cause, value);
-    if (ret != ESP_OK) {
+    esp_err_t ret = sinricpro_core_send_event(device_id, "changeChannel",
+                                              cause, value, handle->limiter);
+    if (ret != ESP_OK && ret != SINRICPRO_ERR_RATE_LIMITED) {
         ESP_LOGE(TAG, "Failed to send channel event: %s", esp_err_to_name(ret));
     }
 
@@ -187,6 +183,6 @@ void sinricpro_channel_controller_destroy(sinricpro_channel_controller_handle_t
 {
     if (handle == NULL) return;
     if (handle->limiter) sinricpro_event_limiter_destroy(handle->limiter);
-    free(handle);
+    sinricpro_object_free(handle);
     ESP_LOGD(TAG, "ChannelController destroyed");
 }
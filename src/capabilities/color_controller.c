@@ -8,6 +8,7 @@
 
 #include "color_controller.h"
 #include "../core/sinricpro_device_internal.h"
+#include "../core/sinricpro_alloc.h"
 #include "../core/sinricpro_event_limiter.h"
 #include "sinricpro_types.h"
 #include <stdlib.h>
@@ -26,7 +27,7 @@ struct sinricpro_color_controller {
 sinricpro_color_controller_handle_t sinricpro_color_controller_create(void)
 {
     sinricpro_color_controller_handle_t handle =
-        malloc(sizeof(struct sinricpro_color_controller));
+        sinricpro_object_alloc(sizeof(struct sinricpro_color_controller));
 
     if (handle == NULL) {
         ESP_LOGE(TAG, "Failed to allocate ColorController");
@@ -39,7 +40,7 @@ sinricpro_color_controller_handle_t sinricpro_color_controller_create(void)
 
     if (handle->limiter == NULL) {
         ESP_LOGE(TAG, "Failed to create event limiter");
-        free(handle);
+        sinricpro_object_free(handle);
         return NULL;
     }
 
@@ -128,12 +129,6 @@ esp_err_t sinricpro_color_controller_send_event(
         return ESP_ERR_INVALID_ARG;
     }
 
-    if (!sinricpro_event_limiter_check(handle->limiter)) {
-        uint32_t wait_ms = sinricpro_event_limiter_time_until_next(handle->limiter);
-        ESP_LOGW(TAG, "Color event rate limited (wait %lu ms)", wait_ms);
-        return SINRICPRO_ERR_RATE_LIMITED;
-    }
-
     ESP_LOGI(TAG, "Sending color event: device=%s, r=%d, g=%d, b=%d, cause=%s",
              device_id, color->r, color->g, color->b, cause);
 
@@ -144,8 +139,8 @@ esp_err_t sinricpro_color_controller_send_event(
     cJSON_AddNumberToObject(color_obj, "b", color->b);
     cJSON_AddItemToObject(value, "color", color_obj);
 
-    esp_err_t ret = sinricpro_core_send_event(device_id, "setColor", cause, value);
-    if (ret != ESP_OK) {
+    esp_err_t ret = sinricpro_core_send_event(device_id, "setColor", cause, value, handle->limiter);
+    if (ret != ESP_OK && ret != SINRICPRO_ERR_RATE_LIMITED) {
         ESP_LOGE(TAG, "Failed to send color event: %s", esp_err_to_name(ret));
     }
 
@@ -156,6 +151,6 @@ void sinricpro_color_controller_destroy(sinricpro_color_controller_handle_t hand
 {
     if (handle == NULL) return;
     if (handle->limiter) sinricpro_event_limiter_destroy(handle->limiter);
-    free(handle);
+    sinricpro_object_free(handle);
     ESP_LOGD(TAG, "ColorController destroyed");
 }
@@ -8,6 +8,7 @@
 
 #include "color_temperature_controller.h"
 #include "../core/sinricpro_device_internal.h"
+#include "../core/sinricpro_alloc.h"
 #include "../core/sinricpro_event_limiter.h"
 #include "sinricpro_types.h"
 #include <stdlib.h>
@@ -28,7 +29,7 @@ struct sinricpro_color_temperature_controller {
 sinricpro_color_temperature_controller_handle_t sinricpro_color_temperature_controller_create(void)
 {
     sinricpro_color_temperature_controller_handle_t handle =
-        malloc(sizeof(struct sinricpro_color_temperature_controller));
+        sinricpro_object_alloc(sizeof(struct sinricpro_color_temperature_controller));
 
     if (handle == NULL) {
         ESP_LOGE(TAG, "Failed to allocate ColorTemperatureController");
@@ -43,7 +44,7 @@ sinricpro_color_temperature_controller_handle_t sinricpro_color_temperature_cont
 
     if (handle->limiter == NULL) {
         ESP_LOGE(TAG, "Failed to create event limiter");
-        free(handle);
+        sinricpro_object_free(handle);
         return NULL;
     }
 
@@ -139,20 +140,15 @@ esp_err_t sinricpro_color_temperature_controller_send_event(
         return ESP_ERR_INVALID_ARG;
     }
 
-    if (!sinricpro_event_limiter_check(handle->limiter)) {
-        uint32_t wait_ms = sinricpro_event_limiter_time_until_next(handle->limiter);
-        ESP_LOGW(TAG, "Color temperature event rate limited (wait %lu ms)", wait_ms);
-        return SINRICPRO_ERR_RATE_LIMITED;
-    }
-
     ESP_LOGI(TAG, "Sending color temperature event: device=%s, value=%dK, cause=%s",
              device_id, color_temperature, cause);
 
     cJSON *value = cJSON_CreateObject();
     cJSON_AddNumberToObject(value, "colorTemperature", color_temperature);
 
-    esp_err_t ret = sinricpro_core_send_event(device_id, "setColorTemperature", cause, value);
-    if (ret != ESP_OK) {
+    esp_err_t ret = sinricpro_core_send_event(device_id, "setColorTemperature",
+                                              cause, value, handle->limiter);
+    if (ret != ESP_OK && ret != SINRICPRO_ERR_RATE_LIMITED) {
         ESP_LOGE(TAG, "Failed to send color temperature event: %s", esp_err_to_name(ret));
     }
 
@@ -163,6 +159,6 @@ void sinricpro_color_temperature_controller_destroy(sinricpro_color_temperature_
 {
     if (handle == NULL) return;
     if (handle->limiter) sinricpro_event_limiter_destroy(handle->limiter);
-    free(handle);
+    sinricpro_object_free(handle);
     ESP_LOGD(TAG, "ColorTemperatureController destroyed");
 }
@@ -8,6 +8,7 @@
 
 #include "equalizer_controller.h"
 #include "../core/sinricpro_device_internal.h"
+#include "../core/sinricpro_alloc.h"
 #include "../core/sinricpro_event_limiter.h"
 #include "sinricpro_types.h"
 #include <stdlib.h>
@@ -26,7 +27,7 @@ struct sinricpro_equalizer_controller {
 sinricpro_equalizer_controller_handle_t sinricpro_equalizer_controller_create(void)
 {
     sinricpro_equalizer_controller_handle_t handle =
-        malloc(sizeof(struct sinricpro_equalizer_controller));
+        sinricpro_object_alloc(sizeof(struct sinricpro_equalizer_controller));
 
     if (handle == NULL) {
         ESP_LOGE(TAG, "Failed to allocate EqualizerController");
@@ -39,7 +40,7 @@ sinricpro_equalizer_controller_handle_t sinricpro_equalizer_controller_create(vo
 
     if (handle->limiter == NULL) {
         ESP_LOGE(TAG, "Failed to create event limiter");
-        free(handle);
+        sinricpro_object_free(handle);
         return NULL;
     }
 
@@ -140,12 +141,6 @@ esp_err_t sinricpro_equalizer_controller_send_event(
         return ESP_ERR_INVALID_ARG;
     }
 
-    if (!sinricpro_event_limiter_check(handle->limiter)) {
-        uint32_t wait_ms = sinricpro_event_limiter_time_until_next(handle->limiter);
-        ESP_LOGW(TAG, "Equalizer event rate limited (wait %lu ms)", wait_ms);
-        return SINRICPRO_ERR_RATE_LIMITED;
-    }
-
     ESP_LOGI(TAG, "Sending equalizer event: device=%s, bass=%d, mid=%d, treble=%d, cause=%s",
              device_id, bands->bass, bands->midrange, bands->treble, cause);
 
@@ -169,8 +164,9 @@ esp_err_t sinricpro_equalizer_controller_send_event(
 
     cJSON_AddItemToObject(value, "bands", bands_array);
 
-    esp_err_t ret = sinricpro_core_send_event(device_id, "setEqualizerBands", cause, value);
-    if (ret != ESP_OK) {
+    esp_err_t ret = sinricpro_core_send_event(device_id, "setEqualizerBands",
+                                              cause, value, handle->limiter);
+    if (ret != ESP_OK && ret != SINRICPRO_ERR_RATE_LIMITED) {
         ESP_LOGE(TAG, "Failed to send equalizer event: %s", esp_err_to_name(ret));
     }
 
@@ -181,6 +177,6 @@ void sinricpro_equalizer_controller_destroy(sinricpro_equalizer_controller_handl
 {
     if (handle == NULL) return;
     if (handle->limiter) sinricpro_event_limiter_destroy(handle->limiter);
-    free(handle);
+    sinricpro_object_free(handle);
     ESP_LOGD(TAG, "EqualizerController destroyed");
 }
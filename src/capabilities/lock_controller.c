@@ -8,6 +8,7 @@
 
 #include "lock_controller.h"
 #include "../core/sinricpro_device_internal.h"
+#include "../core/sinricpro_alloc.h"
 #include "../core/sinricpro_event_limiter.h"
 #include "sinricpro_types.h"
 #include <stdlib.h>
@@ -26,7 +27,7 @@ struct sinricpro_lock_controller {
 sinricpro_lock_controller_handle_t sinricpro_lock_controller_create(void)
 {
     sinricpro_lock_controller_handle_t handle =
-        malloc(sizeof(struct sinricpro_lock_controller));
+        sinricpro_object_alloc(sizeof(struct sinricpro_lock_controller));
 
     if (handle == NULL) {
         ESP_LOGE(TAG, "Failed to allocate LockController");
@@ -39,7 +40,7 @@ sinricpro_lock_controller_handle_t sinricpro_lock_controller_create(void)
 
     if (handle->limiter == NULL) {
         ESP_LOGE(TAG, "Failed to create event limiter");
-        free(handle);
+        sinricpro_object_free(handle);
         return NULL;
     }
 
@@ -114,20 +115,15 @@ esp_err_t sinricpro_lock_controller_send_event(
         return ESP_ERR_INVALID_ARG;
     }
 
-    if (!sinricpro_event_limiter_check(handle->limiter)) {
-        uint32_t wait_ms = sinricpro_event_limiter_time_until_next(handle->limiter);
-        ESP_LOGW(TAG, "Lock state event rate limited (wait %lu ms)", wait_ms);
-        return SINRICPRO_ERR_RATE_LIMITED;
-    }
-
     ESP_LOGI(TAG, "Sending lock state event: device=%s, state=%s, cause=%s",
              device_id, state ? "LOCKED" : "UNLOCKED", cause);
 
     cJSON *value = cJSON_CreateObject();
     cJSON_AddStringToObject(value, "state", state ? "LOCKED" : "UNLOCKED");
 
-    esp_err_t ret = sinricpro_core_send_event(device_id, "setLockState", cause, value);
-    if (ret != ESP_OK) {
+    esp_err_t ret = sinricpro_core_send_event(device_id, "setLockState",
+                                              cause, value, handle->limiter);
+    if (ret != ESP_OK && ret != SINRICPRO_ERR_RATE_LIMITED) {
         ESP_LOGE(TAG, "Failed to send lock state event: %s", esp_err_to_name(ret));
     }
 
@@ -138,6 +134,6 @@ void sinricpro_lock_controller_destroy(sinricpro_lock_controller_handle_t handle
 {
     if (handle == NULL) return;
     if (handle->limiter) sinricpro_event_limiter_destroy(handle->limiter);
-    free(handle);
+    sinricpro_object_free(handle);
     ESP_LOGD(TAG, "LockController destroyed");
 }
@@ -8,6 +8,7 @@
 
 #include "media_controller.h"
 #include "../core/sinricpro_device_internal.h"
+#include "../core/sinricpro_alloc.h"
 #include "../core/sinricpro_event_limiter.h"
 #include "sinricpro_types.h"
 #include <stdlib.h>
@@ -26,7 +27,7 @@ struct sinricpro_media_controller {
 sinricpro_media_controller_handle_t sinricpro_media_controller_create(void)
 {
     sinricpro_media_controller_handle_t handle =
-        malloc(sizeof(struct sinricpro_media_controller));
+        sinricpro_object_alloc(sizeof(struct sinricpro_media_controller));
 
     if (handle == NULL) {
         ESP_LOGE(TAG, "Failed to allocate MediaController");
@@ -39,7 +40,7 @@ sinricpro_media_controller_handle_t sinricpro_media_controller_create(void)
 
     if (handle->limiter == NULL) {
         ESP_LOGE(TAG, "Failed to create event limiter");
-        free(handle);
+        sinricpro_object_free(handle);
         return NULL;
     }
 
@@ -106,20 +107,15 @@ esp_err_t sinricpro_media_controller_send_event(
         return ESP_ERR_INVALID_ARG;
     }
 
-    if (!sinricpro_event_limiter_check(handle->limiter)) {
-        uint32_t wait_ms = sinricpro_event_limiter_time_until_next(handle->limiter);
-        ESP_LOGW(TAG, "Media control event rate limited (wait %lu ms)", wait_ms);
-        return SINRICPRO_ERR_RATE_LIMITED;
-    }
-
     ESP_LOGI(TAG, "Sending media control event: device=%s, control=%s, cause=%s",
              device_id, control, cause);
 
     cJSON *value = cJSON_CreateObject();
     cJSON_AddStringToObject(value, "control", control);
 
-    esp_err_t ret = sinricpro_core_send_event(device_id, "mediaControl", cause, value);
-    if (ret != ESP_OK) {
+    esp_err_t ret = sinricpro_core_send_event(device_id, "mediaControl",
+                                              cause, value, handle->limiter);
+    if (ret != ESP_OK && ret != SINRICPRO_ERR_RATE_LIMITED) {
         ESP_LOGE(TAG, "Failed to send media control event: %s", esp_err_to_name(ret));
     }
 
@@ -130,6 +126,6 @@ void sinricpro_media_controller_destroy(sinricpro_media_controller_handle_t hand
 {
     if (handle == NULL) return;
     if (handle->limiter) sinricpro_event_limiter_destroy(handle->limiter);
-    free(handle);
+    sinricpro_object_free(handle);
     ESP_LOGD(TAG, "MediaController destroyed");
 }
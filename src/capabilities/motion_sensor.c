@@ -8,6 +8,7 @@
 
 #include "motion_sensor.h"
 #include "../core/sinricpro_device_internal.h"
+#include "../core/sinricpro_alloc.h"
 #include "../core/sinricpro_event_limiter.h"
 #include "sinricpro_types.h"
 #include <stdlib.h>
@@ -27,7 +28,7 @@ struct sinricpro_motion_sensor {
 sinricpro_motion_sensor_handle_t sinricpro_motion_sensor_capability_create(void)
 {
     sinricpro_motion_sensor_handle_t handle =
-        malloc(sizeof(struct sinricpro_motion_sensor));
+        sinricpro_object_alloc(sizeof(struct sinricpro_motion_sensor));
 
     if (handle == NULL) {
         ESP_LOGE(TAG, "Failed to allocate MotionSensor");
@@ -38,7 +39,7 @@ sinricpro_motion_sensor_handle_t sinricpro_motion_sensor_capability_create(void)
 
     if (handle->limiter == NULL) {
         ESP_LOGE(TAG, "Failed to create event limiter");
-        free(handle);
+        sinricpro_object_free(handle);
         return NULL;
     }
 
@@ -57,13 +58,6 @@ esp_err_t sinricpro_motion_sensor_send_event(
         return ESP_ERR_INVALID_ARG;
     }
 
-    /* Check rate limit */
-    if (!sinricpro_event_limiter_check(handle->limiter)) {
-        uint32_t wait_ms = sinricpro_event_limiter_time_until_next(handle->limiter);
-        ESP_LOGW(TAG, "Motion event rate limited (wait %lu ms)", wait_ms);
-        return SINRICPRO_ERR_RATE_LIMITED;
-    }
-
     ESP_LOGI(TAG, "Sending motion event: device=%s, detected=%s, cause=%s",
              device_id, detected ? "true" : "false", cause);
 
@@ -72,9 +66,9 @@ esp_err_t sinricpro_motion_sensor_send_event(
     cJSON_AddStringToObject(value, "state", detected ? "detected" : "notDetected");
 
     /* Send event */
-    esp_err_t ret = sinricpro_core_send_event(device_id, "motion", cause, value);
+    esp_err_t ret = sinricpro_core_send_event(device_id, "motion", cause, value, handle->limiter);
 
-    if (ret != ESP_OK) {
+    if (ret != ESP_OK && ret != SINRICPRO_ERR_RATE_LIMITED) {
         ESP_LOGE(TAG, "Failed to send motion event: %s", esp_err_to_name(ret));
     }
 
@@ -91,7 +85,7 @@ void sinricpro_motion_sensor_destroy(sinricpro_motion_sensor_handle_t handle)
         sinricpro_event_limiter_destroy(handle->limiter);
     }
 
-    free(handle);
+    sinricpro_object_free(handle);
 
     ESP_LOGD(TAG, "MotionSensor destroyed");
 }
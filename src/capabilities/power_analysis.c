@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2019-2025 Sinric. All rights reserved.
+ * Licensed under Creative Commons Attribution-Share Alike (CC BY-SA)
+ *
+ * This file is part of the SinricPro ESP-IDF component
+ * (https://github.com/sinricpro/esp-idf)
+ */
+
+#include "sinricpro_power_analysis.h"
+#include <string.h>
+#include <math.h>
+
+#define MAX_ADC_BITS 13
+
+/*
+ * Samples per inner block. With 13-bit data a centered sample and a product
+ * of two fit in 2^26, so 16 products sum to at most 2^30 and the inner loop
+ * can accumulate in 32-bit registers; the 64-bit sums are touched once per
+ * block.
+ */
+#define BLOCK_PAIRS 16
+
+bool sinricpro_power_analyzer_init(sinricpro_power_analyzer_t *analyzer,
+                                   const sinricpro_power_analysis_config_t *config)
+{
+    if (analyzer == NULL || config == NULL ||
+        config->adc_bits == 0 || config->adc_bits > MAX_ADC_BITS ||
+        config->window_samples == 0 ||
+        config->voltage_offset >= (1u << config->adc_bits) ||
+        config->current_offset >= (1u << config->adc_bits)) {
+        return false;
+    }
+
+    memset(analyzer, 0, sizeof(*analyzer));
+    analyzer->config = *config;
+    analyzer->mask = (uint16_t)((1u << config->adc_bits) - 1);
+
+    return true;
+}
+
+static void accumulate(sinricpro_power_analyzer_t *analyzer, const uint16_t *samples, size_t pairs)
+{
+    const uint32_t mask = analyzer->mask;
+    const int32_t v_offset = analyzer->config.voltage_offset;
+    const int32_t i_offset = analyzer->config.current_offset;
+
+    while (pairs > 0) {
+        int block = pairs < BLOCK_PAIRS ? (int)pairs : BLOCK_PAIRS;
+        int32_t sv = 0, si = 0, svv = 0, sii = 0, svi = 0;
+
+        for (int n = 0; n < block; n++) {
+            int32_t v = (int32_t)(samples[0] & mask) - v_offset;
+            int32_t i = (int32_t)(samples[1] & mask) - i_offset;
+            samples += 2;
+
+            sv += v;
+            si += i;
+            svv += v * v;
+            sii += i * i;
+            svi += v * i;
+        }
+
+        analyzer->sum_v += sv;
+        analyzer->sum_i += si;
+        analyzer->sum_vv += svv;
+        analyzer->sum_ii += sii;
+        analyzer->sum_vi += svi;
+        pairs -= block;
+    }
+}
+
+static void finish_window(sinricpro_power_analyzer_t *analyzer, sinricpro_power_reading_t *reading)
+{
+    const double n = analyzer->count;
+    const double mean_v = analyzer->sum_v / n;
+    const double mean_i = analyzer->sum_i / n;
+
+    /* Variance and covariance about the window mean drop any DC offset */
+    double var_v = analyzer->sum_vv / n - mean_v * mean_v;
+    double var_i = analyzer->sum_ii / n - mean_i * mean_i;
+    double cov_vi = analyzer->sum_vi / n - mean_v * mean_i;
+
+    double v_rms = sqrt(var_v > 0.0 ? var_v : 0.0) * analyzer->config.voltage_scale;
+    double i_rms = sqrt(var_i > 0.0 ? var_i : 0.0) * analyzer->config.current_scale;
+    double real = cov_vi * analyzer->config.voltage_scale * analyzer->config.current_scale;
+    double apparent = v_rms * i_rms;
+    double reactive_sq = apparent * apparent - real * real;
+
+    reading->voltage = (float)v_rms;
+    reading->current = (float)i_rms;
+    reading->power = (float)real;
+    reading->apparent_power = (float)apparent;
+    reading->reactive_power = (float)sqrt(reactive_sq > 0.0 ? reactive_sq : 0.0);
+    reading->factor = apparent > 0.0 ? (float)(real / apparent) : 0.0f;
+
+    analyzer->count = 0;
+    analyzer->sum_v = 0;
+    analyzer->sum_i = 0;
+    analyzer->sum_vv = 0;
+    analyzer->sum_ii = 0;
+    analyzer->sum_vi = 0;
+}
+
+bool sinricpro_power_analyzer_feed(sinricpro_power_analyzer_t *analyzer,
+                                   const uint16_t **samples,
+                                   size_t *pairs,
+                                   sinricpro_power_reading_t *reading)
+{
+    if (analyzer == NULL || samples == NULL || *samples == NULL || pairs == NULL) {
+        return false;
+    }
+
+    size_t take = analyzer->config.window_samples - analyzer->count;
+    if (take > *pairs) {
+        take = *pairs;
+    }
+
+    accumulate(analyzer, *samples, take);
+    analyzer->count += take;
+    *samples += 2 * take;
+    *pairs -= take;
+
+    if (analyzer->count < analyzer->config.window_samples) {
+        return false;
+    }
+
+    if (reading != NULL) {
+        finish_window(analyzer, reading);
+    } else {
+        sinricpro_power_reading_t discard;
+        finish_window(analyzer, &discard);
+    }
+
+    return true;
+}
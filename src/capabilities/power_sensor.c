@@ -8,26 +8,160 @@
 
 #include "power_sensor.h"
 #include "../core/sinricpro_device_internal.h"
+#include "../core/sinricpro_alloc.h"
 #include "../core/sinricpro_event_limiter.h"
+#include "../core/sinricpro_report_engine.h"
 #include "sinricpro_types.h"
 #include "sinricpro.h"
 #include <stdlib.h>
 #include <string.h>
+#include <inttypes.h>
 #include "esp_log.h"
+#include "esp_timer.h"
 #include "cJSON.h"
+#if CONFIG_SINRICPRO_POWER_ENERGY_NVS
+#include "nvs.h"
+#endif
 
 static const char *TAG = "power_sensor";
 
+#define US_PER_HOUR 3600000000.0
+
+#if CONFIG_SINRICPRO_POWER_ENERGY_NVS
+#define ENERGY_NVS_NAMESPACE "sinricpro"
+#define ENERGY_NVS_VERSION   1
+
+/* Layout of the NVS blob; bump ENERGY_NVS_VERSION when it changes */
+typedef struct {
+    uint32_t version;
+    double total_wh;
+    double reported_wh;
+} energy_record_t;
+#endif
+
 struct sinricpro_power_sensor {
     sinricpro_event_limiter_handle_t limiter;
-    uint32_t start_time;
+    sinricpro_report_handle_t report;   /* Created with the first policy */
+    sinricpro_power_analyzer_t *analyzer;   /* Created with the first analysis config */
+    uint32_t start_time;                /* Server time of the last report */
+
+    /* Energy: trapezoidal integral of the power samples over esp_timer time */
+    int64_t last_sample_us;             /* 0 = no sample since boot */
     float last_power;
+    double total_wh;                    /* Since the counter was reset */
+    double reported_wh;                 /* total_wh at the last report */
+#if CONFIG_SINRICPRO_POWER_ENERGY_NVS
+    bool restored;                      /* NVS record loaded (or found absent) */
+    bool dirty;                         /* Counters changed since the last save */
+    char nvs_key[16];
+    int64_t saved_us;
+#endif
 };
 
+#if CONFIG_SINRICPRO_POWER_ENERGY_NVS
+static void energy_restore(sinricpro_power_sensor_handle_t handle, const char *device_id)
+{
+    if (handle->restored) {
+        return;
+    }
+    handle->restored = true;
+    handle->saved_us = esp_timer_get_time();
+
+    /* NVS keys are limited to 15 characters; device IDs are longer */
+    uint32_t hash = 2166136261u;
+    for (const char *c = device_id; *c; c++) {
+        hash = (hash ^ (uint8_t)*c) * 16777619u;
+    }
+    snprintf(handle->nvs_key, sizeof(handle->nvs_key), "pwr%08" PRIx32, hash);
+
+    nvs_handle_t nvs;
+    esp_err_t ret = nvs_open(ENERGY_NVS_NAMESPACE, NVS_READONLY, &nvs);
+    if (ret != ESP_OK) {
+        if (ret != ESP_ERR_NVS_NOT_FOUND) {
+            ESP_LOGW(TAG, "Energy counter not restored: %s", esp_err_to_name(ret));
+        }
+        return;
+    }
+
+    energy_record_t record;
+    size_t length = sizeof(record);
+    ret = nvs_get_blob(nvs, handle->nvs_key, &record, &length);
+    nvs_close(nvs);
+
+    if (ret != ESP_OK || length != sizeof(record) || record.version != ENERGY_NVS_VERSION) {
+        return;
+    }
+
+    /* Energy counted before the first sample of this boot is kept */
+    handle->total_wh += record.total_wh;
+    handle->reported_wh += record.reported_wh;
+    ESP_LOGI(TAG, "Energy counter restored: %.3f Wh", handle->total_wh);
+}
+
+static void energy_save(sinricpro_power_sensor_handle_t handle, bool force)
+{
+    if (!handle->restored || handle->nvs_key[0] == '\0') {
+        return;
+    }
+
+    /* Spread flash wear: at most one write per save interval */
+    int64_t now = esp_timer_get_time();
+    if (!handle->dirty ||
+        (!force && now - handle->saved_us < (int64_t)CONFIG_SINRICPRO_POWER_ENERGY_SAVE_INTERVAL * 1000000)) {
+        return;
+    }
+    handle->saved_us = now;
+
+    nvs_handle_t nvs;
+    esp_err_t ret = nvs_open(ENERGY_NVS_NAMESPACE, NVS_READWRITE, &nvs);
+    if (ret == ESP_OK) {
+        energy_record_t record = {
+            .version = ENERGY_NVS_VERSION,
+            .total_wh = handle->total_wh,
+            .reported_wh = handle->reported_wh,
+        };
+        ret = nvs_set_blob(nvs, handle->nvs_key, &record, sizeof(record));
+        if (ret == ESP_OK) {
+            ret = nvs_commit(nvs);
+        }
+        nvs_close(nvs);
+    }
+
+    if (ret == ESP_OK) {
+        handle->dirty = false;
+    } else {
+        ESP_LOGW(TAG, "Failed to save energy counter: %s", esp_err_to_name(ret));
+    }
+}
+
+static inline void energy_changed(sinricpro_power_sensor_handle_t handle)
+{
+    handle->dirty = true;
+}
+#else
+#define energy_restore(handle, device_id) do { } while (0)
+#define energy_save(handle, force)        do { } while (0)
+#define energy_changed(handle)            do { } while (0)
+#endif
+
+static void energy_integrate(sinricpro_power_sensor_handle_t handle, float power)
+{
+    int64_t now = esp_timer_get_time();
+
+    if (handle->last_sample_us > 0) {
+        int64_t elapsed_us = now - handle->last_sample_us;
+        handle->total_wh += (handle->last_power + power) / 2.0 * elapsed_us / US_PER_HOUR;
+        energy_changed(handle);
+    }
+
+    handle->last_sample_us = now;
+    handle->last_power = power;
+}
+
 sinricpro_power_sensor_handle_t sinricpro_power_sensor_capability_create(void)
 {
     sinricpro_power_sensor_handle_t handle =
-        malloc(sizeof(struct sinricpro_power_sensor));
+        sinricpro_object_alloc(sizeof(struct sinricpro_power_sensor));
 
     if (handle == NULL) {
         ESP_LOGE(TAG, "Failed to allocate PowerSensor");
@@ -35,12 +169,23 @@ sinricpro_power_sensor_handle_t sinricpro_power_sensor_capability_create(void)
     }
 
     handle->limiter = sinricpro_event_limiter_create(SINRICPRO_EVENT_LIMIT_SENSOR);
+    handle->report = NULL;
+    handle->analyzer = NULL;
     handle->start_time = 0;
+    handle->last_sample_us = 0;
     handle->last_power = 0.0f;
+    handle->total_wh = 0.0;
+    handle->reported_wh = 0.0;
+#if CONFIG_SINRICPRO_POWER_ENERGY_NVS
+    handle->restored = false;
+    handle->dirty = false;
+    handle->nvs_key[0] = '\0';
+    handle->saved_us = 0;
+#endif
 
     if (handle->limiter == NULL) {
         ESP_LOGE(TAG, "Failed to create event limiter");
-        free(handle);
+        sinricpro_object_free(handle);
         return NULL;
     }
 
@@ -48,7 +193,7 @@ sinricpro_power_sensor_handle_t sinricpro_power_sensor_capability_create(void)
     return handle;
 }
 
-esp_err_t sinricpro_power_sensor_send_event(
+static esp_err_t power_sensor_report(
     sinricpro_power_sensor_handle_t handle,
     const char *device_id,
     float voltage,
@@ -57,18 +202,9 @@ esp_err_t sinricpro_power_sensor_send_event(
     float apparent_power,
     float reactive_power,
     float factor,
-    const char *cause)
+    const char *cause,
+    bool integrate)
 {
-    if (handle == NULL || device_id == NULL || cause == NULL) {
-        return ESP_ERR_INVALID_ARG;
-    }
-
-    if (!sinricpro_event_limiter_check(handle->limiter)) {
-        uint32_t wait_ms = sinricpro_event_limiter_time_until_next(handle->limiter);
-        ESP_LOGW(TAG, "Power sensor event rate limited (wait %lu ms)", wait_ms);
-        return SINRICPRO_ERR_RATE_LIMITED;
-    }
-
     /* Calculate power if not provided */
     if (power < 0.0f) {
         power = voltage * current;
@@ -79,14 +215,15 @@ esp_err_t sinricpro_power_sensor_send_event(
         factor = (apparent_power > 0.0f) ? (power / apparent_power) : 0.0f;
     }
 
+    energy_restore(handle, device_id);
+    if (integrate) {
+        energy_integrate(handle, power);
+    }
+
     uint32_t current_time = sinricpro_get_timestamp();
-    float watt_hours = 0.0f;
 
-    /* Calculate watt-hours if we have previous data */
-    if (handle->start_time > 0) {
-        uint32_t elapsed = current_time - handle->start_time;
-        watt_hours = (elapsed * handle->last_power) / 3600.0f;
-    }
+    /* Everything since the last report that was sent, however many failed */
+    double watt_hours = handle->total_wh - handle->reported_wh;
 
     ESP_LOGI(TAG, "Sending power sensor event: device=%s, V=%.1f, A=%.2f, W=%.1f",
              device_id, voltage, current, power);
@@ -100,23 +237,218 @@ esp_err_t sinricpro_power_sensor_send_event(
     cJSON_AddNumberToObject(value, "reactivePower", reactive_power);
     cJSON_AddNumberToObject(value, "factor", factor);
     cJSON_AddNumberToObject(value, "wattHours", watt_hours);
+    cJSON_AddNumberToObject(value, "totalWattHours", handle->total_wh);
 
-    /* Update tracking state */
-    handle->start_time = current_time;
-    handle->last_power = power;
-
-    esp_err_t ret = sinricpro_core_send_event(device_id, "powerUsage", cause, value);
-    if (ret != ESP_OK) {
+    esp_err_t ret = sinricpro_core_send_event(device_id, "powerUsage",
+                                              cause, value, handle->limiter);
+    if (ret == ESP_OK) {
+        /* The next report covers the time since this one */
+        handle->start_time = current_time;
+        handle->reported_wh = handle->total_wh;
+        energy_changed(handle);
+        energy_save(handle, false);
+    } else if (ret != SINRICPRO_ERR_RATE_LIMITED) {
         ESP_LOGE(TAG, "Failed to send power sensor event: %s", esp_err_to_name(ret));
     }
 
     return ret;
 }
 
+esp_err_t sinricpro_power_sensor_send_event(
+    sinricpro_power_sensor_handle_t handle,
+    const char *device_id,
+    float voltage,
+    float current,
+    float power,
+    float apparent_power,
+    float reactive_power,
+    float factor,
+    const char *cause)
+{
+    if (handle == NULL || device_id == NULL || cause == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    return power_sensor_report(handle, device_id, voltage, current, power,
+                               apparent_power, reactive_power, factor, cause, true);
+}
+
+esp_err_t sinricpro_power_sensor_capability_add_power_sample(
+    sinricpro_power_sensor_handle_t handle,
+    const char *device_id,
+    float power)
+{
+    if (handle == NULL || device_id == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    energy_restore(handle, device_id);
+    energy_integrate(handle, power);
+    energy_save(handle, false);
+
+    return ESP_OK;
+}
+
+esp_err_t sinricpro_power_sensor_capability_get_energy(
+    sinricpro_power_sensor_handle_t handle,
+    const char *device_id,
+    double *total_wh,
+    double *interval_wh)
+{
+    if (handle == NULL || device_id == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    energy_restore(handle, device_id);
+
+    if (total_wh) *total_wh = handle->total_wh;
+    if (interval_wh) *interval_wh = handle->total_wh - handle->reported_wh;
+
+    return ESP_OK;
+}
+
+esp_err_t sinricpro_power_sensor_capability_reset_energy(
+    sinricpro_power_sensor_handle_t handle,
+    const char *device_id)
+{
+    if (handle == NULL || device_id == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    energy_restore(handle, device_id);
+    handle->total_wh = 0.0;
+    handle->reported_wh = 0.0;
+    energy_changed(handle);
+    energy_save(handle, true);
+
+    return ESP_OK;
+}
+
+esp_err_t sinricpro_power_sensor_capability_set_report_policy(
+    sinricpro_power_sensor_handle_t handle,
+    const sinricpro_report_policy_t *policy)
+{
+    if (handle == NULL || policy == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    return sinricpro_report_configure(&handle->report, 6, policy, SINRICPRO_EVENT_LIMIT_SENSOR);
+}
+
+esp_err_t sinricpro_power_sensor_capability_push_sample(
+    sinricpro_power_sensor_handle_t handle,
+    const char *device_id,
+    float voltage,
+    float current,
+    float power,
+    float apparent_power,
+    float reactive_power,
+    float factor)
+{
+    if (handle == NULL || device_id == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    if (handle->report == NULL) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    /* Derive per sample: the mean of V * I is not mean V * mean I */
+    if (power < 0.0f) {
+        power = voltage * current;
+    }
+    if (factor < 0.0f && apparent_power >= 0.0f) {
+        factor = (apparent_power > 0.0f) ? (power / apparent_power) : 0.0f;
+    }
+
+    energy_restore(handle, device_id);
+    energy_integrate(handle, power);
+    energy_save(handle, false);
+
+    const float samples[6] = { voltage, current, power, apparent_power, reactive_power, factor };
+    float values[6];
+
+    sinricpro_report_due_t due = sinricpro_report_push(handle->report, samples, values);
+    if (due == SINRICPRO_REPORT_NOT_DUE) {
+        return ESP_OK;
+    }
+
+    /* powerUsage is never shadowed, so heartbeats need no special case */
+    esp_err_t ret = power_sensor_report(handle, device_id,
+                                        values[0], values[1], values[2],
+                                        values[3], values[4], values[5],
+                                        SINRICPRO_CAUSE_PERIODIC_POLL, false);
+    sinricpro_report_done(handle->report, values, ret == ESP_OK);
+
+    return ret;
+}
+
+esp_err_t sinricpro_power_sensor_capability_set_analysis(
+    sinricpro_power_sensor_handle_t handle,
+    const sinricpro_power_analysis_config_t *config)
+{
+    if (handle == NULL || config == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    sinricpro_power_analyzer_t analyzer;
+    if (!sinricpro_power_analyzer_init(&analyzer, config)) {
+        ESP_LOGE(TAG, "Invalid analysis config");
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    if (handle->analyzer == NULL) {
+        handle->analyzer = sinricpro_object_alloc(sizeof(sinricpro_power_analyzer_t));
+        if (handle->analyzer == NULL) {
+            ESP_LOGE(TAG, "Failed to allocate analyzer");
+            return ESP_ERR_NO_MEM;
+        }
+    }
+
+    *handle->analyzer = analyzer;
+    return ESP_OK;
+}
+
+esp_err_t sinricpro_power_sensor_capability_process_samples(
+    sinricpro_power_sensor_handle_t handle,
+    const char *device_id,
+    const uint16_t *samples,
+    size_t pairs)
+{
+    if (handle == NULL || device_id == NULL || (samples == NULL && pairs > 0)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    if (handle->analyzer == NULL || handle->report == NULL) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    esp_err_t result = ESP_OK;
+    sinricpro_power_reading_t reading;
+
+    while (pairs > 0 && sinricpro_power_analyzer_feed(handle->analyzer, &samples, &pairs, &reading)) {
+        esp_err_t ret = sinricpro_power_sensor_capability_push_sample(handle, device_id,
+                                                                      reading.voltage,
+                                                                      reading.current,
+                                                                      reading.power,
+                                                                      reading.apparent_power,
+                                                                      reading.reactive_power,
+                                                                      reading.factor);
+        if (result == ESP_OK) {
+            result = ret;
+        }
+    }
+
+    return result;
+}
+
 void sinricpro_power_sensor_destroy(sinricpro_power_sensor_handle_t handle)
 {
     if (handle == NULL) return;
     if (handle->limiter) sinricpro_event_limiter_destroy(handle->limiter);
-    free(handle);
+    sinricpro_report_destroy(handle->report);
+    if (handle->analyzer) sinricpro_object_free(handle->analyzer);
+    energy_save(handle, true);
+    sinricpro_object_free(handle);
     ESP_LOGD(TAG, "PowerSensor destroyed");
 }
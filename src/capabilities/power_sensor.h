@@ -10,6 +10,8 @@
 #define POWER_SENSOR_H
 
 #include "sinricpro_types.h"
+#include "sinricpro_report.h"
+#include "sinricpro_power_analysis.h"
 #include <stdint.h>
 
 #ifdef __cplusplus
@@ -31,6 +33,45 @@ esp_err_t sinricpro_power_sensor_send_event(
     float factor,
     const char *cause);
 
+esp_err_t sinricpro_power_sensor_capability_add_power_sample(
+    sinricpro_power_sensor_handle_t handle,
+    const char *device_id,
+    float power);
+
+esp_err_t sinricpro_power_sensor_capability_get_energy(
+    sinricpro_power_sensor_handle_t handle,
+    const char *device_id,
+    double *total_wh,
+    double *interval_wh);
+
+esp_err_t sinricpro_power_sensor_capability_reset_energy(
+    sinricpro_power_sensor_handle_t handle,
+    const char *device_id);
+
+esp_err_t sinricpro_power_sensor_capability_set_report_policy(
+    sinricpro_power_sensor_handle_t handle,
+    const sinricpro_report_policy_t *policy);
+
+esp_err_t sinricpro_power_sensor_capability_push_sample(
+    sinricpro_power_sensor_handle_t handle,
+    const char *device_id,
+    float voltage,
+    float current,
+    float power,
+    float apparent_power,
+    float reactive_power,
+    float factor);
+
+esp_err_t sinricpro_power_sensor_capability_set_analysis(
+    sinricpro_power_sensor_handle_t handle,
+    const sinricpro_power_analysis_config_t *config);
+
+esp_err_t sinricpro_power_sensor_capability_process_samples(
+    sinricpro_power_sensor_handle_t handle,
+    const char *device_id,
+    const uint16_t *samples,
+    size_t pairs);
+
 void sinricpro_power_sensor_destroy(sinricpro_power_sensor_handle_t handle);
 
 #ifdef __cplusplus
@@ -8,6 +8,7 @@
 
 #include "power_state_controller.h"
 #include "../core/sinricpro_device_internal.h"
+#include "../core/sinricpro_alloc.h"
 #include "../core/sinricpro_event_limiter.h"
 #include <string.h>
 #include "esp_log.h"
@@ -27,7 +28,7 @@ struct sinricpro_power_state_controller {
 sinricpro_power_state_controller_handle_t sinricpro_power_state_controller_create(void)
 {
     sinricpro_power_state_controller_handle_t handle =
-        malloc(sizeof(struct sinricpro_power_state_controller));
+        sinricpro_object_alloc(sizeof(struct sinricpro_power_state_controller));
 
     if (handle == NULL) {
         ESP_LOGE(TAG, "Failed to allocate PowerStateController");
@@ -40,7 +41,7 @@ sinricpro_power_state_controller_handle_t sinricpro_power_state_controller_creat
 
     if (handle->limiter == NULL) {
         ESP_LOGE(TAG, "Failed to create event limiter");
-        free(handle);
+        sinricpro_object_free(handle);
         return NULL;
     }
 
@@ -117,13 +118,6 @@ esp_err_t sinricpro_power_state_controller_send_event(
         return ESP_ERR_INVALID_ARG;
     }
 
-    /* Check rate limit */
-    if (!sinricpro_event_limiter_check(handle->limiter)) {
-        uint32_t wait_ms = sinricpro_event_limiter_time_until_next(handle->limiter);
-        ESP_LOGW(TAG, "PowerState event rate limited (wait %lu ms)", wait_ms);
-        return SINRICPRO_ERR_RATE_LIMITED;
-    }
-
     ESP_LOGI(TAG, "Sending PowerState event: device=%s, state=%s, cause=%s",
              device_id, state ? "ON" : "OFF", cause);
 
@@ -132,9 +126,10 @@ esp_err_t sinricpro_power_state_controller_send_event(
     cJSON_AddStringToObject(value, "state", state ? "On" : "Off");
 
     /* Send event (value is consumed by send_event) */
-    esp_err_t ret = sinricpro_core_send_event(device_id, "setPowerState", cause, value);
+    esp_err_t ret = sinricpro_core_send_event(device_id, "setPowerState",
+                                              cause, value, handle->limiter);
 
-    if (ret != ESP_OK) {
+    if (ret != ESP_OK && ret != SINRICPRO_ERR_RATE_LIMITED) {
         ESP_LOGE(TAG, "Failed to send PowerState event: %s", esp_err_to_name(ret));
     }
 
@@ -151,7 +146,7 @@ void sinricpro_power_state_controller_destroy(sinricpro_power_state_controller_h
         sinricpro_event_limiter_destroy(handle->limiter);
     }
 
-    free(handle);
+    sinricpro_object_free(handle);
 
     ESP_LOGD(TAG, "PowerStateController destroyed");
 }
@@ -29,7 +29,8 @@ esp_err_t sinricpro_send_push_notification(const char *device_id, const char *me
     /* Send event (value is consumed by send_event) */
     esp_err_t ret = sinricpro_core_send_event(device_id, "pushNotification",
                                                 SINRICPRO_CAUSE_PHYSICAL_INTERACTION,
-                                                value);
+                                                value,
+                                                NULL);
 
     if (ret != ESP_OK) {
         ESP_LOGE(TAG, "Failed to send push notification: %s", esp_err_to_name(ret));
@@ -7,6 +7,7 @@
  */
 
 #include "setting_controller.h"
+#include "../core/sinricpro_alloc.h"
 #include <string.h>
 #include "esp_log.h"
 #include "cJSON.h"
@@ -24,7 +25,7 @@ struct sinricpro_setting_controller {
 sinricpro_setting_controller_handle_t sinricpro_setting_controller_create(void)
 {
     sinricpro_setting_controller_handle_t handle =
-        malloc(sizeof(struct sinricpro_setting_controller));
+        sinricpro_object_alloc(sizeof(struct sinricpro_setting_controller));
 
     if (handle == NULL) {
         ESP_LOGE(TAG, "Failed to allocate SettingController");
@@ -105,7 +106,7 @@ bool sinricpro_setting_controller_handle_request(
 void sinricpro_setting_controller_destroy(sinricpro_setting_controller_handle_t handle)
 {
     if (handle != NULL) {
-        free(handle);
+        sinricpro_object_free(handle);
         ESP_LOGD(TAG, "SettingController destroyed");
     }
 }
@@ -8,7 +8,9 @@
 
 #include "temperature_sensor.h"
 #include "../core/sinricpro_device_internal.h"
+#include "../core/sinricpro_alloc.h"
 #include "../core/sinricpro_event_limiter.h"
+#include "../core/sinricpro_report_engine.h"
 #include "sinricpro_types.h"
 #include <stdlib.h>
 #include <string.h>
@@ -23,12 +25,13 @@ static const char *TAG = "temp_sensor";
  */
 struct sinricpro_temperature_sensor {
     sinricpro_event_limiter_handle_t limiter;
+    sinricpro_report_handle_t report;   /* Created with the first policy */
 };
 
 sinricpro_temperature_sensor_handle_t sinricpro_temperature_sensor_capability_create(void)
 {
     sinricpro_temperature_sensor_handle_t handle =
-        malloc(sizeof(struct sinricpro_temperature_sensor));
+        sinricpro_object_alloc(sizeof(struct sinricpro_temperature_sensor));
 
     if (handle == NULL) {
         ESP_LOGE(TAG, "Failed to allocate TemperatureSensor");
@@ -36,10 +39,11 @@ sinricpro_temperature_sensor_handle_t sinricpro_temperature_sensor_capability_cr
     }
 
     handle->limiter = sinricpro_event_limiter_create(SINRICPRO_EVENT_LIMIT_SENSOR);
+    handle->report = NULL;
 
     if (handle->limiter == NULL) {
         ESP_LOGE(TAG, "Failed to create event limiter");
-        free(handle);
+        sinricpro_object_free(handle);
         return NULL;
     }
 
@@ -59,13 +63,6 @@ esp_err_t sinricpro_temperature_sensor_send_event(
         return ESP_ERR_INVALID_ARG;
     }
 
-    /* Check rate limit */
-    if (!sinricpro_event_limiter_check(handle->limiter)) {
-        uint32_t wait_ms = sinricpro_event_limiter_time_until_next(handle->limiter);
-        ESP_LOGW(TAG, "Temperature event rate limited (wait %lu ms)", wait_ms);
-        return SINRICPRO_ERR_RATE_LIMITED;
-    }
-
     ESP_LOGI(TAG, "Sending temperature event: device=%s, temp=%.1f, humidity=%.1f, cause=%s",
              device_id, temperature, humidity, cause);
 
@@ -76,15 +73,60 @@ esp_err_t sinricpro_temperature_sensor_send_event(
     cJSON_AddNumberToObject(value, "humidity", roundf(humidity * 100.0f) / 100.0f);
 
     /* Send event */
-    esp_err_t ret = sinricpro_core_send_event(device_id, "currentTemperature", cause, value);
+    esp_err_t ret = sinricpro_core_send_event(device_id, "currentTemperature",
+                                              cause, value, handle->limiter);
 
-    if (ret != ESP_OK) {
+    if (ret != ESP_OK && ret != SINRICPRO_ERR_RATE_LIMITED) {
         ESP_LOGE(TAG, "Failed to send temperature event: %s", esp_err_to_name(ret));
     }
 
     return ret;
 }
 
+esp_err_t sinricpro_temperature_sensor_capability_set_report_policy(
+    sinricpro_temperature_sensor_handle_t handle,
+    const sinricpro_report_policy_t *policy)
+{
+    if (handle == NULL || policy == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    return sinricpro_report_configure(&handle->report, 2, policy, SINRICPRO_EVENT_LIMIT_SENSOR);
+}
+
+esp_err_t sinricpro_temperature_sensor_capability_push_sample(
+    sinricpro_temperature_sensor_handle_t handle,
+    const char *device_id,
+    float temperature,
+    float humidity)
+{
+    if (handle == NULL || device_id == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    if (handle->report == NULL) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    const float samples[2] = { temperature, humidity };
+    float values[2];
+
+    sinricpro_report_due_t due = sinricpro_report_push(handle->report, samples, values);
+    if (due == SINRICPRO_REPORT_NOT_DUE) {
+        return ESP_OK;
+    }
+
+    if (due == SINRICPRO_REPORT_HEARTBEAT) {
+        sinricpro_core_forget_state(device_id, "currentTemperature");
+    }
+
+    esp_err_t ret = sinricpro_temperature_sensor_send_event(handle, device_id, values[0], values[1],
+                                                            SINRICPRO_CAUSE_PERIODIC_POLL);
+    sinricpro_report_done(handle->report, values, ret == ESP_OK);
+
+    return ret;
+}
+
 void sinricpro_temperature_sensor_destroy(sinricpro_temperature_sensor_handle_t handle)
 {
     if (handle == NULL) {
@@ -95,7 +137,9 @@ void sinricpro_temperature_sensor_destroy(sinricpro_temperature_sensor_handle_t
         sinricpro_event_limiter_destroy(handle->limiter);
     }
 
-    free(handle);
+    sinricpro_report_destroy(handle->report);
+
+    sinricpro_object_free(handle);
 
     ESP_LOGD(TAG, "TemperatureSensor destroyed");
 }
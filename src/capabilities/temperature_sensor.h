@@ -10,6 +10,7 @@
 #define TEMPERATURE_SENSOR_H
 
 #include "sinricpro_types.h"
+#include "sinricpro_report.h"
 #include <stdbool.h>
 
 #ifdef __cplusplus
@@ -46,6 +47,35 @@ esp_err_t sinricpro_temperature_sensor_send_event(
     float humidity,
     const char *cause);
 
+/**
+ * @brief Set the reporting policy applied to pushed samples
+ *
+ * @param[in] handle Sensor handle
+ * @param[in] policy Policy
+ *
+ * @return ESP_OK on success
+ */
+esp_err_t sinricpro_temperature_sensor_capability_set_report_policy(
+    sinricpro_temperature_sensor_handle_t handle,
+    const sinricpro_report_policy_t *policy);
+
+/**
+ * @brief Add a reading and report if the policy says so
+ *
+ * @param[in] handle      Sensor handle
+ * @param[in] device_id   Device ID
+ * @param[in] temperature Temperature in Celsius
+ * @param[in] humidity    Humidity in % (use -1.0f if not available)
+ *
+ * @return ESP_OK if the sample was taken (and any report queued),
+ *         ESP_ERR_INVALID_STATE without a policy, or the send error
+ */
+esp_err_t sinricpro_temperature_sensor_capability_push_sample(
+    sinricpro_temperature_sensor_handle_t handle,
+    const char *device_id,
+    float temperature,
+    float humidity);
+
 /**
  * @brief Destroy TemperatureSensor
  *
@@ -8,6 +8,7 @@
 
 #include "thermostat_controller.h"
 #include "../core/sinricpro_device_internal.h"
+#include "../core/sinricpro_alloc.h"
 #include "../core/sinricpro_event_limiter.h"
 #include "sinricpro_types.h"
 #include <stdlib.h>
@@ -53,7 +54,7 @@ static sinricpro_thermostat_mode_t string_to_mode(const char *mode_str)
 sinricpro_thermostat_controller_handle_t sinricpro_thermostat_controller_create(void)
 {
     sinricpro_thermostat_controller_handle_t handle =
-        malloc(sizeof(struct sinricpro_thermostat_controller));
+        sinricpro_object_alloc(sizeof(struct sinricpro_thermostat_controller));
 
     if (handle == NULL) {
         ESP_LOGE(TAG, "Failed to allocate ThermostatController");
@@ -70,7 +71,7 @@ sinricpro_thermostat_controller_handle_t sinricpro_thermostat_controller_create(
 
     if (handle->limiter == NULL) {
         ESP_LOGE(TAG, "Failed to create event limiter");
-        free(handle);
+        sinricpro_object_free(handle);
         return NULL;
     }
 
@@ -205,12 +206,6 @@ esp_err_t sinricpro_thermostat_controller_send_mode_event(
         return ESP_ERR_INVALID_ARG;
     }
 
-    if (!sinricpro_event_limiter_check(handle->limiter)) {
-        uint32_t wait_ms = sinricpro_event_limiter_time_until_next(handle->limiter);
-        ESP_LOGW(TAG, "Thermostat mode event rate limited (wait %lu ms)", wait_ms);
-        return SINRICPRO_ERR_RATE_LIMITED;
-    }
-
     const char *mode_str = mode_to_string(mode);
     ESP_LOGI(TAG, "Sending thermostat mode event: device=%s, mode=%s, cause=%s",
              device_id, mode_str, cause);
@@ -218,8 +213,9 @@ esp_err_t sinricpro_thermostat_controller_send_mode_event(
     cJSON *value = cJSON_CreateObject();
     cJSON_AddStringToObject(value, "thermostatMode", mode_str);
 
-    esp_err_t ret = sinricpro_core_send_event(device_id, "setThermostatMode", cause, value);
-    if (ret != ESP_OK) {
+    esp_err_t ret = sinricpro_core_send_event(device_id, "setThermostatMode",
+                                              cause, value, handle->limiter);
+    if (ret != ESP_OK && ret != SINRICPRO_ERR_RATE_LIMITED) {
         ESP_LOGE(TAG, "Failed to send thermostat mode event: %s", esp_err_to_name(ret));
     }
 
@@ -236,20 +232,15 @@ esp_err_t sinricpro_thermostat_controller_send_target_temperature_event(
         return ESP_ERR_INVALID_ARG;
     }
 
-    if (!sinricpro_event_limiter_check(handle->limiter)) {
-        uint32_t wait_ms = sinricpro_event_limiter_time_until_next(handle->limiter);
-        ESP_LOGW(TAG, "Target temperature event rate limited (wait %lu ms)", wait_ms);
-        return SINRICPRO_ERR_RATE_LIMITED;
-    }
-
     ESP_LOGI(TAG, "Sending target temperature event: device=%s, temp=%.1f°C, cause=%s",
              device_id, temperature, cause);
 
     cJSON *value = cJSON_CreateObject();
     cJSON_AddNumberToObject(value, "temperature", roundf(temperature * 10.0f) / 10.0f);
 
-    esp_err_t ret = sinricpro_core_send_event(device_id, "targetTemperature", cause, value);
-    if (ret != ESP_OK) {
+    esp_err_t ret = sinricpro_core_send_event(device_id, "targetTemperature",
+                                              cause, value, handle->limiter);
+    if (ret != ESP_OK && ret != SINRICPRO_ERR_RATE_LIMITED) {
         ESP_LOGE(TAG, "Failed to send target temperature event: %s", esp_err_to_name(ret));
     }
 
@@ -260,6 +251,6 @@ void sinricpro_thermostat_controller_destroy(sinricpro_thermostat_controller_han
 {
     if (handle == NULL) return;
     if (handle->limiter) sinricpro_event_limiter_destroy(handle->limiter);
-    free(handle);
+    sinricpro_object_free(handle);
     ESP_LOGD(TAG, "ThermostatController destroyed");
 }
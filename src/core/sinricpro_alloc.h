@@ -0,0 +1,159 @@
+/*
+ * Copyright (c) 2019-2025 Sinric. All rights reserved.
+ * Licensed under Creative Commons Attribution-Share Alike (CC BY-SA)
+ *
+ * This file is part of the SinricPro ESP-IDF component
+ * (https://github.com/sinricpro/esp-idf)
+ */
+
+#ifndef SINRICPRO_ALLOC_H
+#define SINRICPRO_ALLOC_H
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include "sdkconfig.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Memory entry points used by the SDK (internal API).
+ *
+ * sinricpro_malloc() and friends serve transient and internal memory
+ * (messages, buffers, cJSON through hooks); sinricpro_object_alloc() serves
+ * long-lived objects (devices, controllers, limiters).
+ *
+ * With CONFIG_SINRICPRO_STATIC_ALLOCATION they come from static pools and an
+ * object arena instead of the heap. With CONFIG_SINRICPRO_ALLOC_STATS the
+ * transient calls are also accounted per operation. With neither option they
+ * are plain libc calls and the operation markers compile to nothing.
+ */
+
+#if CONFIG_SINRICPRO_STATIC_ALLOCATION
+
+#include "sinricpro_static.h"
+
+void *sinricpro_pool_malloc(size_t size);
+void *sinricpro_pool_calloc(size_t count, size_t size);
+void *sinricpro_pool_realloc(void *ptr, size_t size);
+char *sinricpro_pool_strdup(const char *str);
+void sinricpro_pool_free(void *ptr);
+
+/**
+ * @brief Usable size of a block returned by the pools (or the heap)
+ */
+size_t sinricpro_pool_block_size(void *ptr);
+
+/**
+ * @brief Carve a long-lived object from the arena
+ *
+ * Consecutive calls return adjacent memory, so the objects that make up one
+ * device stay together.
+ */
+void *sinricpro_object_alloc(size_t size);
+
+/**
+ * @brief Release a long-lived object
+ *
+ * Arena memory is not reused; deleting and re-creating devices consumes
+ * arena space.
+ */
+void sinricpro_object_free(void *ptr);
+
+#define SINRICPRO_HEAP_MALLOC(size)         sinricpro_pool_malloc(size)
+#define SINRICPRO_HEAP_CALLOC(count, size)  sinricpro_pool_calloc((count), (size))
+#define SINRICPRO_HEAP_REALLOC(ptr, size)   sinricpro_pool_realloc((ptr), (size))
+#define SINRICPRO_HEAP_STRDUP(str)          sinricpro_pool_strdup(str)
+#define SINRICPRO_HEAP_FREE(ptr)            sinricpro_pool_free(ptr)
+#define SINRICPRO_HEAP_SIZE(ptr)            sinricpro_pool_block_size(ptr)
+
+#else
+
+#define SINRICPRO_HEAP_MALLOC(size)         malloc(size)
+#define SINRICPRO_HEAP_CALLOC(count, size)  calloc((count), (size))
+#define SINRICPRO_HEAP_REALLOC(ptr, size)   realloc((ptr), (size))
+#define SINRICPRO_HEAP_STRDUP(str)          strdup(str)
+#define SINRICPRO_HEAP_FREE(ptr)            free(ptr)
+#define SINRICPRO_HEAP_SIZE(ptr)            heap_caps_get_allocated_size(ptr)
+
+#define sinricpro_object_alloc(size)        malloc(size)
+#define sinricpro_object_free(ptr)          free(ptr)
+
+#endif /* CONFIG_SINRICPRO_STATIC_ALLOCATION */
+
+#if CONFIG_SINRICPRO_ALLOC_STATS
+
+#include "sinricpro_alloc_stats.h"
+
+void *sinricpro_malloc(size_t size);
+void *sinricpro_calloc(size_t count, size_t size);
+void *sinricpro_realloc(void *ptr, size_t size);
+char *sinricpro_strdup(const char *str);
+void sinricpro_free(void *ptr);
+
+/**
+ * @brief Start attributing the calling task's allocations to an operation
+ *
+ * @param[in] op           Operation type
+ * @param[in] continuation true if this pass continues an operation already
+ *                         counted (e.g., signing an event on the send task)
+ */
+void sinricpro_alloc_op_begin(sinricpro_alloc_op_t op, bool continuation);
+
+/**
+ * @brief Finish the calling task's current pass
+ */
+void sinricpro_alloc_op_end(void);
+
+/**
+ * @brief Stop or resume accounting on the calling task
+ *
+ * For code that stands in for the network (the loopback sink), whose
+ * allocations are not the SDK's.
+ *
+ * @param[in] paused true to stop accounting, false to resume
+ */
+void sinricpro_alloc_op_pause(bool paused);
+
+#define SINRICPRO_ALLOC_OP_BEGIN(op)     sinricpro_alloc_op_begin((op), false)
+#define SINRICPRO_ALLOC_OP_CONTINUE(op)  sinricpro_alloc_op_begin((op), true)
+#define SINRICPRO_ALLOC_OP_END()         sinricpro_alloc_op_end()
+#define SINRICPRO_ALLOC_OP_PAUSE()       sinricpro_alloc_op_pause(true)
+#define SINRICPRO_ALLOC_OP_RESUME()      sinricpro_alloc_op_pause(false)
+
+#else
+
+#define sinricpro_malloc(size)           SINRICPRO_HEAP_MALLOC(size)
+#define sinricpro_calloc(count, size)    SINRICPRO_HEAP_CALLOC((count), (size))
+#define sinricpro_realloc(ptr, size)     SINRICPRO_HEAP_REALLOC((ptr), (size))
+#define sinricpro_strdup(str)            SINRICPRO_HEAP_STRDUP(str)
+#define sinricpro_free(ptr)              SINRICPRO_HEAP_FREE(ptr)
+
+#define SINRICPRO_ALLOC_OP_BEGIN(op)     do { } while (0)
+#define SINRICPRO_ALLOC_OP_CONTINUE(op)  do { } while (0)
+#define SINRICPRO_ALLOC_OP_END()         do { } while (0)
+#define SINRICPRO_ALLOC_OP_PAUSE()       do { } while (0)
+#define SINRICPRO_ALLOC_OP_RESUME()      do { } while (0)
+
+#endif /* CONFIG_SINRICPRO_ALLOC_STATS */
+
+#if CONFIG_SINRICPRO_ALLOC_STATS || CONFIG_SINRICPRO_STATIC_ALLOCATION
+
+/**
+ * @brief Route cJSON allocations through sinricpro_malloc()/sinricpro_free()
+ */
+void sinricpro_alloc_install_hooks(void);
+
+#else
+
+#define sinricpro_alloc_install_hooks()  do { } while (0)
+
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SINRICPRO_ALLOC_H */
@@ -0,0 +1,307 @@
+/*
+ * Copyright (c) 2019-2025 Sinric. All rights reserved.
+ * Licensed under Creative Commons Attribution-Share Alike (CC BY-SA)
+ *
+ * This file is part of the SinricPro ESP-IDF component
+ * (https://github.com/sinricpro/esp-idf)
+ */
+
+#include "sinricpro_alloc.h"
+#include "sinricpro_alloc_stats.h"
+#include <string.h>
+#include "esp_log.h"
+#include "esp_heap_caps.h"
+#include "cJSON.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+static const char *TAG = "sinricpro_alloc";
+
+/* Receive task, send task and up to two application tasks raising events */
+#define ALLOC_TRACKED_TASKS 4
+
+/**
+ * @brief One pass of an operation on one task
+ *
+ * Only the owning task updates the counters, so the allocation hooks need no
+ * lock; claiming and releasing a slot happens in a critical section.
+ */
+typedef struct {
+    TaskHandle_t task;          /**< Owning task (NULL = free slot) */
+    sinricpro_alloc_op_t op;
+    bool continuation;
+    uint8_t nesting;            /**< Passes begun inside this one */
+    bool paused;
+    uint32_t allocations;
+    uint32_t frees;
+    int32_t live_bytes;
+    int32_t peak_bytes;
+} alloc_pass_t;
+
+static const char *const op_names[SINRICPRO_ALLOC_OP_MAX] = {
+    "request", "response", "event", "reconnect",
+};
+
+static struct {
+    alloc_pass_t passes[ALLOC_TRACKED_TASKS];
+    sinricpro_alloc_stats_t stats[SINRICPRO_ALLOC_OP_MAX];
+    sinricpro_alloc_budget_t budgets[SINRICPRO_ALLOC_OP_MAX];
+    portMUX_TYPE lock;
+} alloc_state = {
+    .lock = portMUX_INITIALIZER_UNLOCKED,
+};
+
+static alloc_pass_t *current_pass(void)
+{
+    TaskHandle_t self = xTaskGetCurrentTaskHandle();
+
+    for (int i = 0; i < ALLOC_TRACKED_TASKS; i++) {
+        if (alloc_state.passes[i].task == self) {
+            return &alloc_state.passes[i];
+        }
+    }
+
+    return NULL;
+}
+
+static void account_alloc(void *ptr)
+{
+    alloc_pass_t *pass = current_pass();
+    if (pass == NULL || pass->paused || ptr == NULL) {
+        return;
+    }
+
+    pass->allocations++;
+    pass->live_bytes += (int32_t)SINRICPRO_HEAP_SIZE(ptr);
+    if (pass->live_bytes > pass->peak_bytes) {
+        pass->peak_bytes = pass->live_bytes;
+    }
+}
+
+static void account_free(void *ptr)
+{
+    alloc_pass_t *pass = current_pass();
+    if (pass == NULL || pass->paused || ptr == NULL) {
+        return;
+    }
+
+    /* Memory allocated before the pass began may drive live_bytes negative */
+    pass->frees++;
+    pass->live_bytes -= (int32_t)SINRICPRO_HEAP_SIZE(ptr);
+}
+
+void *sinricpro_malloc(size_t size)
+{
+    void *ptr = SINRICPRO_HEAP_MALLOC(size);
+    account_alloc(ptr);
+    return ptr;
+}
+
+void *sinricpro_calloc(size_t count, size_t size)
+{
+    void *ptr = SINRICPRO_HEAP_CALLOC(count, size);
+    account_alloc(ptr);
+    return ptr;
+}
+
+void *sinricpro_realloc(void *ptr, size_t size)
+{
+    account_free(ptr);
+    void *result = SINRICPRO_HEAP_REALLOC(ptr, size);
+    account_alloc(result != NULL ? result : ptr);
+    return result;
+}
+
+char *sinricpro_strdup(const char *str)
+{
+    char *copy = SINRICPRO_HEAP_STRDUP(str);
+    account_alloc(copy);
+    return copy;
+}
+
+void sinricpro_free(void *ptr)
+{
+    account_free(ptr);
+    SINRICPRO_HEAP_FREE(ptr);
+}
+
+void sinricpro_alloc_install_hooks(void)
+{
+    /*
+     * cJSON only uses realloc when its hooks are the libc functions, so with
+     * accounting enabled printing takes its malloc-and-copy path instead.
+     */
+    cJSON_Hooks hooks = {
+        .malloc_fn = sinricpro_malloc,
+        .free_fn = sinricpro_free,
+    };
+    cJSON_InitHooks(&hooks);
+}
+
+void sinricpro_alloc_op_begin(sinricpro_alloc_op_t op, bool continuation)
+{
+    if (op >= SINRICPRO_ALLOC_OP_MAX) {
+        return;
+    }
+
+    TaskHandle_t self = xTaskGetCurrentTaskHandle();
+    alloc_pass_t *slot = NULL;
+
+    portENTER_CRITICAL(&alloc_state.lock);
+    for (int i = 0; i < ALLOC_TRACKED_TASKS; i++) {
+        if (alloc_state.passes[i].task == self) {
+            /* e.g. an event raised from a request callback: charge the outer pass */
+            alloc_state.passes[i].nesting++;
+            portEXIT_CRITICAL(&alloc_state.lock);
+            return;
+        }
+    }
+    for (int i = 0; i < ALLOC_TRACKED_TASKS && slot == NULL; i++) {
+        if (alloc_state.passes[i].task == NULL) {
+            slot = &alloc_state.passes[i];
+        }
+    }
+    if (slot) {
+        memset(slot, 0, sizeof(alloc_pass_t));
+        slot->op = op;
+        slot->continuation = continuation;
+        slot->task = self;
+    }
+    portEXIT_CRITICAL(&alloc_state.lock);
+
+    if (slot == NULL) {
+        ESP_LOGD(TAG, "No free slot, %s pass not accounted", op_names[op]);
+    }
+}
+
+void sinricpro_alloc_op_end(void)
+{
+    alloc_pass_t *pass = current_pass();
+    if (pass == NULL) {
+        return;
+    }
+
+    bool over = false;
+
+    portENTER_CRITICAL(&alloc_state.lock);
+    if (pass->nesting > 0) {
+        pass->nesting--;
+        portEXIT_CRITICAL(&alloc_state.lock);
+        return;
+    }
+
+    sinricpro_alloc_stats_t *stats = &alloc_state.stats[pass->op];
+    const sinricpro_alloc_budget_t *budget = &alloc_state.budgets[pass->op];
+    uint32_t peak = pass->peak_bytes > 0 ? (uint32_t)pass->peak_bytes : 0;
+
+    if (!pass->continuation) {
+        stats->operations++;
+    }
+    stats->allocations += pass->allocations;
+    stats->frees += pass->frees;
+    if (pass->allocations > stats->max_allocations) {
+        stats->max_allocations = pass->allocations;
+    }
+    if (peak > stats->peak_bytes) {
+        stats->peak_bytes = peak;
+    }
+    if ((budget->max_allocations && pass->allocations > budget->max_allocations) ||
+        (budget->max_peak_bytes && peak > budget->max_peak_bytes)) {
+        stats->over_budget++;
+        over = true;
+    }
+
+    alloc_pass_t finished = *pass;
+    pass->task = NULL;
+    portEXIT_CRITICAL(&alloc_state.lock);
+
+    if (over) {
+        ESP_LOGW(TAG, "%s over budget: %lu allocations, %lu bytes peak",
+                 op_names[finished.op],
+                 (unsigned long)finished.allocations,
+                 (unsigned long)peak);
+    }
+}
+
+void sinricpro_alloc_op_pause(bool paused)
+{
+    alloc_pass_t *pass = current_pass();
+    if (pass != NULL) {
+        pass->paused = paused;
+    }
+}
+
+esp_err_t sinricpro_alloc_stats_get(sinricpro_alloc_op_t op, sinricpro_alloc_stats_t *stats)
+{
+    if (op >= SINRICPRO_ALLOC_OP_MAX || stats == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    portENTER_CRITICAL(&alloc_state.lock);
+    *stats = alloc_state.stats[op];
+    portEXIT_CRITICAL(&alloc_state.lock);
+
+    return ESP_OK;
+}
+
+void sinricpro_alloc_stats_reset(void)
+{
+    portENTER_CRITICAL(&alloc_state.lock);
+    memset(alloc_state.stats, 0, sizeof(alloc_state.stats));
+    portEXIT_CRITICAL(&alloc_state.lock);
+}
+
+esp_err_t sinricpro_alloc_stats_set_budget(sinricpro_alloc_op_t op,
+                                            const sinricpro_alloc_budget_t *budget)
+{
+    if (op >= SINRICPRO_ALLOC_OP_MAX) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    portENTER_CRITICAL(&alloc_state.lock);
+    if (budget) {
+        alloc_state.budgets[op] = *budget;
+    } else {
+        memset(&alloc_state.budgets[op], 0, sizeof(sinricpro_alloc_budget_t));
+    }
+    portEXIT_CRITICAL(&alloc_state.lock);
+
+    return ESP_OK;
+}
+
+esp_err_t sinricpro_alloc_stats_check(void)
+{
+    esp_err_t ret = ESP_OK;
+
+    portENTER_CRITICAL(&alloc_state.lock);
+    for (int op = 0; op < SINRICPRO_ALLOC_OP_MAX; op++) {
+        if (alloc_state.stats[op].over_budget > 0) {
+            ret = ESP_FAIL;
+        }
+    }
+    portEXIT_CRITICAL(&alloc_state.lock);
+
+    return ret;
+}
+
+void sinricpro_alloc_stats_log(void)
+{
+    for (int op = 0; op < SINRICPRO_ALLOC_OP_MAX; op++) {
+        sinricpro_alloc_stats_t stats;
+        sinricpro_alloc_stats_get((sinricpro_alloc_op_t)op, &stats);
+
+        if (stats.operations == 0 && stats.allocations == 0) {
+            continue;
+        }
+
+        ESP_LOGI(TAG, "%-9s ops=%lu allocs=%lu (%.1f/op, max %lu/pass) frees=%lu peak=%lu B over_budget=%lu",
+                 op_names[op],
+                 (unsigned long)stats.operations,
+                 (unsigned long)stats.allocations,
+                 stats.operations ? (double)stats.allocations / stats.operations : 0.0,
+                 (unsigned long)stats.max_allocations,
+                 (unsigned long)stats.frees,
+                 (unsigned long)stats.peak_bytes,
+                 (unsigned long)stats.over_budget);
+    }
+}
@@ -0,0 +1,46 @@
+/*
+ * Copyright (c) 2019-2025 Sinric. All rights reserved.
+ * Licensed under Creative Commons Attribution-Share Alike (CC BY-SA)
+ *
+ * This file is part of the SinricPro ESP-IDF component
+ * (https://github.com/sinricpro/esp-idf)
+ */
+
+#ifndef SINRICPRO_CAPTURE_HOOK_H
+#define SINRICPRO_CAPTURE_HOOK_H
+
+#include "sdkconfig.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if CONFIG_SINRICPRO_CAPTURE
+
+#include "sinricpro_capture.h"
+
+/**
+ * @brief Record one frame if a capture is running (internal API)
+ *
+ * @param[in] direction Frame direction
+ * @param[in] data      Frame data
+ * @param[in] length    Frame length
+ */
+void sinricpro_capture_record(sinricpro_capture_direction_t direction,
+                              const char *data,
+                              size_t length);
+
+#define SINRICPRO_CAPTURE_FRAME(direction, data, length) \
+    sinricpro_capture_record((direction), (data), (length))
+
+#else
+
+#define SINRICPRO_CAPTURE_FRAME(direction, data, length) do { } while (0)
+
+#endif /* CONFIG_SINRICPRO_CAPTURE */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SINRICPRO_CAPTURE_HOOK_H */
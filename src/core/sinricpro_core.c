@@ -8,9 +8,12 @@
 
 #include "sinricpro.h"
 #include "sinricpro_device_internal.h"
+#include "sinricpro_state_shadow.h"
 #include "sinricpro_websocket.h"
 #include "sinricpro_signature.h"
 #include "sinricpro_message_queue.h"
+#include "sinricpro_capture_hook.h"
+#include "sinricpro_alloc.h"
 #include <string.h>
 #include <stdio.h>
 #include "esp_log.h"
@@ -23,6 +26,11 @@
 
 static const char *TAG = "sinricpro_core";
 
+/* Initial print buffer for outgoing messages; most responses and events fit */
+#define MESSAGE_PRINT_BUFFER 384
+
+#define SEND_TASK_STACK_SIZE 4096
+
 ESP_EVENT_DEFINE_BASE(SINRICPRO_EVENT);
 
 /**
@@ -38,6 +46,11 @@ static struct {
     bool started;
     SemaphoreHandle_t mutex;
     TaskHandle_t send_task;
+#if CONFIG_SINRICPRO_STATIC_ALLOCATION
+    StaticSemaphore_t mutex_buffer;
+    StaticTask_t send_task_buffer;
+    StackType_t send_task_stack[SEND_TASK_STACK_SIZE / sizeof(StackType_t)];
+#endif
 } core_state = {0};
 
 /* Forward declarations */
@@ -173,38 +186,44 @@ static void handle_request(cJSON *json_message)
     sinricpro_device_t *device = find_device(device_id);
     xSemaphoreGive(core_state.mutex);
 
-    /* Prepare response */
+    /*
+     * Prepare response. Keys are string literals and the copied strings live
+     * in the request, which outlives the response, so neither is duplicated.
+     */
     cJSON *response = cJSON_CreateObject();
     cJSON *response_header = cJSON_CreateObject();
     cJSON *response_payload = cJSON_CreateObject();
     cJSON *response_value = cJSON_CreateObject();
 
-    cJSON_AddItemToObject(response, "header", response_header);
-    cJSON_AddNumberToObject(response_header, "payloadVersion", 2);
-    cJSON_AddNumberToObject(response_header, "signatureVersion", 1);
+    cJSON_AddItemToObjectCS(response, "header", response_header);
+    cJSON_AddItemToObjectCS(response_header, "payloadVersion", cJSON_CreateNumber(2));
+    cJSON_AddItemToObjectCS(response_header, "signatureVersion", cJSON_CreateNumber(1));
 
-    cJSON_AddItemToObject(response, "payload", response_payload);
-    cJSON_AddStringToObject(response_payload, "action", action);
-    cJSON_AddNumberToObject(response_payload, "createdAt", core_state.timestamp);
-    cJSON_AddStringToObject(response_payload, "deviceId", device_id);
+    cJSON_AddItemToObjectCS(response, "payload", response_payload);
+    cJSON_AddItemToObjectCS(response_payload, "action", cJSON_CreateStringReference(action));
+    cJSON_AddItemToObjectCS(response_payload, "createdAt", cJSON_CreateNumber(core_state.timestamp));
+    cJSON_AddItemToObjectCS(response_payload, "deviceId", cJSON_CreateStringReference(device_id));
 
     /* Copy replyToken and clientId from request */
     cJSON *reply_token = cJSON_GetObjectItem(payload, "replyToken");
     if (reply_token) {
-        cJSON_AddStringToObject(response_payload, "replyToken", reply_token->valuestring);
+        cJSON_AddItemToObjectCS(response_payload, "replyToken",
+                                cJSON_CreateStringReference(reply_token->valuestring));
     }
 
     cJSON *client_id = cJSON_GetObjectItem(payload, "clientId");
     if (client_id) {
-        cJSON_AddStringToObject(response_payload, "clientId", client_id->valuestring);
+        cJSON_AddItemToObjectCS(response_payload, "clientId",
+                                cJSON_CreateStringReference(client_id->valuestring));
     }
 
     if (instance_id) {
-        cJSON_AddStringToObject(response_payload, "instanceId", instance_id);
+        cJSON_AddItemToObjectCS(response_payload, "instanceId",
+                                cJSON_CreateStringReference(instance_id));
     }
 
-    cJSON_AddStringToObject(response_payload, "type", "response");
-    cJSON_AddItemToObject(response_payload, "value", response_value);
+    cJSON_AddItemToObjectCS(response_payload, "type", cJSON_CreateStringReference("response"));
+    cJSON_AddItemToObjectCS(response_payload, "value", response_value);
 
     bool success = false;
 
@@ -213,18 +232,24 @@ static void handle_request(cJSON *json_message)
         success = device->request_handler(device_id, action, instance_id,
                                            request_value, response_value,
                                            device->user_data);
+#if CONFIG_SINRICPRO_STATE_SHADOW
+        if (success) {
+            sinricpro_state_apply_response(device, action, instance_id,
+                                           request_value, response_value);
+        }
+#endif
     } else {
         ESP_LOGW(TAG, "No handler for device: %s", device_id);
     }
 
-    cJSON_AddBoolToObject(response_payload, "success", success);
-    cJSON_AddStringToObject(response_payload, "message", success ? "OK" : "Device did not handle request");
+    cJSON_AddItemToObjectCS(response_payload, "success", cJSON_CreateBool(success));
+    cJSON_AddItemToObjectCS(response_payload, "message",
+                            cJSON_CreateStringReference(success ? "OK" : "Device did not handle request"));
 
-    /* Send response */
-    char *response_str = cJSON_PrintUnformatted(response);
+    /* Send response; the queue takes the printed buffer */
+    char *response_str = cJSON_PrintBuffered(response, MESSAGE_PRINT_BUFFER, false);
     if (response_str) {
-        sinricpro_message_queue_push(core_state.send_queue, response_str);
-        free(response_str);
+        sinricpro_message_queue_push_owned(core_state.send_queue, response_str);
     }
 
     cJSON_Delete(response);
@@ -239,10 +264,12 @@ static void handle_timestamp(cJSON *json_message)
     }
 }
 
-static void handle_received_message(const char *data, size_t length, void *context)
+static void process_received_message(const char *data, size_t length)
 {
     ESP_LOGD(TAG, "Received message (len=%zu): %.*s", length, (int)length, data);
 
+    SINRICPRO_CAPTURE_FRAME(SINRICPRO_CAPTURE_INBOUND, data, length);
+
     /* Parse JSON */
     cJSON *json = cJSON_Parse(data);
     if (json == NULL) {
@@ -301,6 +328,13 @@ static void handle_received_message(const char *data, size_t length, void *conte
     cJSON_Delete(json);
 }
 
+static void handle_received_message(const char *data, size_t length, void *context)
+{
+    SINRICPRO_ALLOC_OP_BEGIN(SINRICPRO_ALLOC_OP_REQUEST);
+    process_received_message(data, length);
+    SINRICPRO_ALLOC_OP_END();
+}
+
 /* ========================================================================
  * Event Sending
  * ======================================================================== */
@@ -308,61 +342,189 @@ static void handle_received_message(const char *data, size_t length, void *conte
 esp_err_t sinricpro_core_send_event(const char *device_id,
                                      const char *action,
                                      const char *cause,
-                                     cJSON *value)
+                                     cJSON *value,
+                                     sinricpro_event_limiter_handle_t limiter)
 {
     if (!core_state.started) {
+        cJSON_Delete(value);
         return SINRICPRO_ERR_NOT_STARTED;
     }
 
     if (!sinricpro_ws_is_connected()) {
+        cJSON_Delete(value);
         return SINRICPRO_ERR_NOT_CONNECTED;
     }
 
-    /* Create event message */
+#if CONFIG_SINRICPRO_STATE_SHADOW
+    xSemaphoreTake(core_state.mutex, portMAX_DELAY);
+    sinricpro_device_t *device = find_device(device_id);
+    xSemaphoreGive(core_state.mutex);
+
+    /* Unchanged values are dropped before they use up the rate limit */
+    if (sinricpro_state_unchanged(device, action, NULL, value)) {
+        ESP_LOGD(TAG, "Event unchanged, not sent: device=%s, action=%s", device_id, action);
+        cJSON_Delete(value);
+        return ESP_OK;
+    }
+#endif
+
+    if (limiter && !sinricpro_event_limiter_check(limiter)) {
+        ESP_LOGW(TAG, "%s event rate limited (wait %lu ms)", action,
+                 sinricpro_event_limiter_time_until_next(limiter));
+        cJSON_Delete(value);
+        return SINRICPRO_ERR_RATE_LIMITED;
+    }
+
+    SINRICPRO_ALLOC_OP_BEGIN(SINRICPRO_ALLOC_OP_EVENT);
+
+    /* Create event message (see handle_request() for the constant keys) */
     cJSON *event = cJSON_CreateObject();
     cJSON *header = cJSON_CreateObject();
     cJSON *payload = cJSON_CreateObject();
     cJSON *cause_obj = cJSON_CreateObject();
 
-    cJSON_AddItemToObject(event, "header", header);
-    cJSON_AddNumberToObject(header, "payloadVersion", 2);
-    cJSON_AddNumberToObject(header, "signatureVersion", 1);
+    cJSON_AddItemToObjectCS(event, "header", header);
+    cJSON_AddItemToObjectCS(header, "payloadVersion", cJSON_CreateNumber(2));
+    cJSON_AddItemToObjectCS(header, "signatureVersion", cJSON_CreateNumber(1));
 
-    cJSON_AddItemToObject(event, "payload", payload);
-    cJSON_AddStringToObject(payload, "action", action);
-    cJSON_AddItemToObject(payload, "cause", cause_obj);
-    cJSON_AddStringToObject(cause_obj, "type", cause);
-    cJSON_AddNumberToObject(payload, "createdAt", 0);  /* Will be set when sending */
-    cJSON_AddStringToObject(payload, "deviceId", device_id);
+    cJSON_AddItemToObjectCS(event, "payload", payload);
+    cJSON_AddItemToObjectCS(payload, "action", cJSON_CreateStringReference(action));
+    cJSON_AddItemToObjectCS(payload, "cause", cause_obj);
+    cJSON_AddItemToObjectCS(cause_obj, "type", cJSON_CreateStringReference(cause));
+    cJSON_AddItemToObjectCS(payload, "createdAt", cJSON_CreateNumber(0));  /* Will be set when sending */
+    cJSON_AddItemToObjectCS(payload, "deviceId", cJSON_CreateStringReference(device_id));
 
     /* Generate unique replyToken (simple UUID-like string) */
     char reply_token[40];
     snprintf(reply_token, sizeof(reply_token), "%08lx-%04x-%04x",
              (unsigned long)esp_random(), (unsigned)(esp_random() & 0xFFFF),
              (unsigned)(esp_random() & 0xFFFF));
-    cJSON_AddStringToObject(payload, "replyToken", reply_token);
+    cJSON_AddItemToObjectCS(payload, "replyToken", cJSON_CreateStringReference(reply_token));
 
-    cJSON_AddStringToObject(payload, "type", "event");
-    cJSON_AddItemToObject(payload, "value", value);
+    cJSON_AddItemToObjectCS(payload, "type", cJSON_CreateStringReference("event"));
+    cJSON_AddItemToObjectCS(payload, "value", value);
 
-    /* Queue for sending */
-    char *event_str = cJSON_PrintUnformatted(event);
+    /* Queue for sending; the queue takes the printed buffer */
+    char *event_str = cJSON_PrintBuffered(event, MESSAGE_PRINT_BUFFER, false);
     esp_err_t ret = ESP_FAIL;
 
     if (event_str) {
-        ret = sinricpro_message_queue_push(core_state.send_queue, event_str);
-        free(event_str);
+        ret = sinricpro_message_queue_push_owned(core_state.send_queue, event_str);
+    }
+
+#if CONFIG_SINRICPRO_STATE_SHADOW
+    if (ret == ESP_OK) {
+        sinricpro_state_update(device, action, NULL, value);
     }
+#endif
 
     cJSON_Delete(event);
 
+    SINRICPRO_ALLOC_OP_END();
+
     return ret;
 }
 
+void sinricpro_core_forget_state(const char *device_id, const char *action)
+{
+#if CONFIG_SINRICPRO_STATE_SHADOW
+    xSemaphoreTake(core_state.mutex, portMAX_DELAY);
+    sinricpro_device_t *device = find_device(device_id);
+    xSemaphoreGive(core_state.mutex);
+
+    sinricpro_state_forget(device, action, NULL);
+#endif
+}
+
 /* ========================================================================
  * Send Task
  * ======================================================================== */
 
+/**
+ * @brief Stamp createdAt and append the signature to a queued message
+ *
+ * Queued messages are printed by the core itself, so the text is edited in
+ * place of parsing and re-printing it: the createdAt value is replaced, the
+ * payload is signed and ,"signature":{...} is appended to the root object.
+ * The result is byte-identical to what cJSON would print.
+ *
+ * @param[in]  message    Queued message
+ * @param[out] out_length Length of the signed message
+ *
+ * @return Signed message (free with sinricpro_free()), or NULL on failure
+ */
+static char *sign_message(const char *message, size_t *out_length)
+{
+    static const char created_at_key[] = "\"createdAt\":";
+    static const char signature_open[] = ",\"signature\":{\"HMAC\":\"";
+    static const char signature_close[] = "\"}}";
+
+    const char *payload = NULL;
+    size_t payload_size = 0;
+    if (sinricpro_find_payload(message, &payload, &payload_size) != ESP_OK) {
+        return NULL;
+    }
+
+    const char *created_at = strstr(payload, created_at_key);
+    size_t length = strlen(message);
+    if (created_at == NULL || created_at >= payload + payload_size ||
+        length == 0 || message[length - 1] != '}') {
+        ESP_LOGE(TAG, "Unexpected message layout");
+        return NULL;
+    }
+
+    const char *value_start = created_at + sizeof(created_at_key) - 1;
+    const char *value_end = value_start;
+    while (*value_end != ',' && *value_end != '}') {
+        value_end++;
+    }
+
+    char stamp[12];
+    int stamp_len = snprintf(stamp, sizeof(stamp), "%lu", (unsigned long)core_state.timestamp);
+
+    size_t capacity = length - (value_end - value_start) + stamp_len +
+                      sizeof(signature_open) - 1 + 64 + sizeof(signature_close);
+    char *out = sinricpro_malloc(capacity);
+    if (out == NULL) {
+        return NULL;
+    }
+
+    /* Everything up to the createdAt value, the new value, the rest of the payload */
+    size_t pos = value_start - message;
+    memcpy(out, message, pos);
+    memcpy(out + pos, stamp, stamp_len);
+    pos += stamp_len;
+    size_t tail = (payload + payload_size) - value_end;
+    memcpy(out + pos, value_end, tail);
+    pos += tail;
+
+    /* Sign the payload as it now stands */
+    size_t out_payload = payload - message;
+    char signature[64];
+    out[pos] = '\0';
+    esp_err_t ret = sinricpro_calculate_signature(core_state.config.app_secret,
+                                                   out + out_payload,
+                                                   signature,
+                                                   sizeof(signature));
+
+    /* Whatever followed the payload, minus the closing brace of the root */
+    size_t rest = (message + length - 1) - (payload + payload_size);
+    memcpy(out + pos, payload + payload_size, rest);
+    pos += rest;
+
+    if (ret == ESP_OK) {
+        pos += snprintf(out + pos, capacity - pos, "%s%s%s",
+                        signature_open, signature, signature_close);
+    } else {
+        out[pos++] = '}';
+        out[pos] = '\0';
+    }
+
+    *out_length = pos;
+
+    return out;
+}
+
 static void send_task_func(void *arg)
 {
     ESP_LOGI(TAG, "Send task started");
@@ -375,43 +537,26 @@ static void send_task_func(void *arg)
                                                       pdMS_TO_TICKS(1000));
 
         if (ret == ESP_OK && message != NULL) {
-            /* Parse and add timestamp and signature */
-            cJSON *json = cJSON_Parse(message);
-            if (json) {
-                cJSON *payload = cJSON_GetObjectItem(json, "payload");
-                if (payload) {
-                    /* Update createdAt with current timestamp */
-                    cJSON_SetNumberValue(cJSON_GetObjectItem(payload, "createdAt"),
-                                          core_state.timestamp);
-
-                    /* Calculate signature */
-                    char *payload_str = cJSON_PrintUnformatted(payload);
-                    if (payload_str) {
-                        char signature[64];
-                        ret = sinricpro_calculate_signature(core_state.config.app_secret,
-                                                             payload_str,
-                                                             signature,
-                                                             sizeof(signature));
-                        if (ret == ESP_OK) {
-                            cJSON *sig_obj = cJSON_CreateObject();
-                            cJSON_AddStringToObject(sig_obj, "HMAC", signature);
-                            cJSON_AddItemToObject(json, "signature", sig_obj);
-                        }
-                        free(payload_str);
-                    }
-
-                    /* Send via WebSocket */
-                    char *signed_message = cJSON_PrintUnformatted(json);
-                    if (signed_message) {
-                        ESP_LOGD(TAG, "Sending: %s", signed_message);
-                        sinricpro_ws_send(signed_message, 0);
-                        free(signed_message);
-                    }
-                }
-                cJSON_Delete(json);
+            if (strstr(message, "\"type\":\"event\"") != NULL) {
+                SINRICPRO_ALLOC_OP_CONTINUE(SINRICPRO_ALLOC_OP_EVENT);
+            } else {
+                SINRICPRO_ALLOC_OP_BEGIN(SINRICPRO_ALLOC_OP_RESPONSE);
+            }
+
+            /* Add timestamp and signature */
+            size_t signed_length = 0;
+            char *signed_message = sign_message(message, &signed_length);
+            if (signed_message) {
+                /* Send via WebSocket */
+                ESP_LOGD(TAG, "Sending: %s", signed_message);
+                SINRICPRO_CAPTURE_FRAME(SINRICPRO_CAPTURE_OUTBOUND,
+                                        signed_message, signed_length);
+                sinricpro_ws_send(signed_message, signed_length);
+                sinricpro_free(signed_message);
             }
 
             sinricpro_message_queue_free_message(message);
+            SINRICPRO_ALLOC_OP_END();
         }
     }
 
@@ -425,8 +570,10 @@ static void send_task_func(void *arg)
 
 static void handle_connected(void *context)
 {
+    SINRICPRO_ALLOC_OP_CONTINUE(SINRICPRO_ALLOC_OP_RECONNECT);
     ESP_LOGI(TAG, "Connected to SinricPro server");
     esp_event_post(SINRICPRO_EVENT, SINRICPRO_EVENT_CONNECTED, NULL, 0, portMAX_DELAY);
+    SINRICPRO_ALLOC_OP_END();
 }
 
 static void handle_disconnected(void *context)
@@ -451,8 +598,14 @@ esp_err_t sinricpro_init(const sinricpro_config_t *config)
         return SINRICPRO_ERR_ALREADY_STARTED;
     }
 
+    sinricpro_alloc_install_hooks();
+
     /* Create mutex */
+#if CONFIG_SINRICPRO_STATIC_ALLOCATION
+    core_state.mutex = xSemaphoreCreateMutexStatic(&core_state.mutex_buffer);
+#else
     core_state.mutex = xSemaphoreCreateMutex();
+#endif
     if (core_state.mutex == NULL) {
         ESP_LOGE(TAG, "Failed to create mutex");
         return ESP_ERR_NO_MEM;
@@ -518,36 +671,53 @@ esp_err_t sinricpro_start(void)
 
     ESP_LOGI(TAG, "Device IDs: %s", device_ids);
 
-    /* Initialize WebSocket */
-    sinricpro_ws_callbacks_t ws_callbacks = {
+    /* Initialize transport */
+    sinricpro_transport_callbacks_t ws_callbacks = {
         .on_receive = handle_received_message,
         .on_connected = handle_connected,
         .on_disconnected = handle_disconnected,
         .context = NULL
     };
 
-    esp_err_t ret = sinricpro_ws_init(CONFIG_SINRICPRO_SERVER_URL,
-                                        CONFIG_SINRICPRO_SERVER_PORT,
-                                        core_state.config.app_key,
-                                        device_ids,
-                                        &ws_callbacks);
+    sinricpro_transport_config_t ws_config = {
+        .server_url = core_state.config.server_url ? core_state.config.server_url
+                                                   : CONFIG_SINRICPRO_SERVER_URL,
+        .server_port = core_state.config.server_port ? core_state.config.server_port
+                                                     : CONFIG_SINRICPRO_SERVER_PORT,
+        .path = CONFIG_SINRICPRO_WEBSOCKET_PATH,
+        .app_key = core_state.config.app_key,
+        .device_ids = device_ids,
+    };
+
+    SINRICPRO_ALLOC_OP_BEGIN(SINRICPRO_ALLOC_OP_RECONNECT);
+    esp_err_t ret = sinricpro_ws_init(core_state.config.transport, &ws_config, &ws_callbacks);
     if (ret != ESP_OK) {
-        ESP_LOGE(TAG, "Failed to initialize WebSocket: %s", esp_err_to_name(ret));
+        SINRICPRO_ALLOC_OP_END();
+        ESP_LOGE(TAG, "Failed to initialize transport: %s", esp_err_to_name(ret));
         return ret;
     }
 
-    /* Start WebSocket */
+    /* Start transport */
     ret = sinricpro_ws_start();
+    SINRICPRO_ALLOC_OP_END();
     if (ret != ESP_OK) {
-        ESP_LOGE(TAG, "Failed to start WebSocket: %s", esp_err_to_name(ret));
+        ESP_LOGE(TAG, "Failed to start transport: %s", esp_err_to_name(ret));
         sinricpro_ws_deinit();
         return ret;
     }
 
     /* Create send task */
     core_state.started = true;
+#if CONFIG_SINRICPRO_STATIC_ALLOCATION
+    core_state.send_task = xTaskCreateStatic(send_task_func, "sinricpro_send",
+                                             SEND_TASK_STACK_SIZE / sizeof(StackType_t),
+                                             NULL, 5, core_state.send_task_stack,
+                                             &core_state.send_task_buffer);
+    BaseType_t task_ret = core_state.send_task ? pdPASS : pdFAIL;
+#else
     BaseType_t task_ret = xTaskCreate(send_task_func, "sinricpro_send",
-                                        4096, NULL, 5, &core_state.send_task);
+                                        SEND_TASK_STACK_SIZE, NULL, 5, &core_state.send_task);
+#endif
     if (task_ret != pdPASS) {
         ESP_LOGE(TAG, "Failed to create send task");
         core_state.started = false;
@@ -10,6 +10,8 @@
 #define SINRICPRO_DEVICE_INTERNAL_H
 
 #include "sinricpro_types.h"
+#include "sinricpro_event_limiter.h"
+#include "sinricpro_state_shadow.h"
 #include "esp_err.h"
 #include "cJSON.h"
 
@@ -49,6 +51,9 @@ typedef struct sinricpro_device {
     sinricpro_device_request_handler_t request_handler;
     void *user_data;
     struct sinricpro_device *next;  /* Linked list */
+#if CONFIG_SINRICPRO_STATE_SHADOW
+    sinricpro_state_slot_t state[CONFIG_SINRICPRO_STATE_SHADOW_SLOTS];  /* Last reported values */
+#endif
 } sinricpro_device_t;
 
 /**
@@ -72,17 +77,37 @@ esp_err_t sinricpro_core_unregister_device(const char *device_id);
 /**
  * @brief Send an event message (internal API)
  *
+ * Events that report only values already in the device's state shadow are
+ * dropped before they reach the rate limiter. value is consumed in every
+ * case.
+ *
  * @param[in] device_id Device ID
  * @param[in] action    Action name
  * @param[in] cause     Cause string
  * @param[in] value     Value JSON object
+ * @param[in] limiter   Event limiter of the capability (NULL = not limited)
  *
- * @return ESP_OK on success, error code otherwise
+ * @return
+ *     - ESP_OK: Event queued, or dropped as unchanged
+ *     - SINRICPRO_ERR_RATE_LIMITED: Too soon after the previous event
+ *     - Other error codes on failure
  */
 esp_err_t sinricpro_core_send_event(const char *device_id,
                                      const char *action,
                                      const char *cause,
-                                     cJSON *value);
+                                     cJSON *value,
+                                     sinricpro_event_limiter_handle_t limiter);
+
+/**
+ * @brief Forget the shadowed state of one action (internal API)
+ *
+ * The next event for the action is sent even if its value is unchanged.
+ * Does nothing without CONFIG_SINRICPRO_STATE_SHADOW.
+ *
+ * @param[in] device_id Device ID
+ * @param[in] action    Action name
+ */
+void sinricpro_core_forget_state(const char *device_id, const char *action);
 
 #ifdef __cplusplus
 }
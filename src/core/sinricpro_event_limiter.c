@@ -7,6 +7,7 @@
  */
 
 #include "sinricpro_event_limiter.h"
+#include "sinricpro_alloc.h"
 #include <stdlib.h>
 #include "esp_log.h"
 #include "freertos/FreeRTOS.h"
@@ -25,7 +26,7 @@ struct sinricpro_event_limiter {
 
 sinricpro_event_limiter_handle_t sinricpro_event_limiter_create(uint32_t min_interval_ms)
 {
-    sinricpro_event_limiter_handle_t handle = malloc(sizeof(struct sinricpro_event_limiter));
+    sinricpro_event_limiter_handle_t handle = sinricpro_object_alloc(sizeof(struct sinricpro_event_limiter));
     if (handle == NULL) {
         ESP_LOGE(TAG, "Failed to allocate event limiter");
         return NULL;
@@ -109,7 +110,7 @@ void sinricpro_event_limiter_reset(sinricpro_event_limiter_handle_t handle)
 void sinricpro_event_limiter_destroy(sinricpro_event_limiter_handle_t handle)
 {
     if (handle != NULL) {
-        free(handle);
+        sinricpro_object_free(handle);
         ESP_LOGD(TAG, "Event limiter destroyed");
     }
 }
@@ -0,0 +1,391 @@
+/*
+ * Copyright (c) 2019-2025 Sinric. All rights reserved.
+ * Licensed under Creative Commons Attribution-Share Alike (CC BY-SA)
+ *
+ * This file is part of the SinricPro ESP-IDF component
+ * (https://github.com/sinricpro/esp-idf)
+ */
+
+#include "sinricpro_input_dispatch.h"
+#include <string.h>
+#include <stdatomic.h>
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "driver/gpio.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+
+static const char *TAG = "sinricpro_input";
+
+#define INPUT_TASK_STACK_SIZE 3072
+#define INPUT_RETRY_MAX_US    (60 * 1000000LL)
+
+/* One edge as seen by the ISR */
+typedef struct {
+    int64_t time_us;
+    uint8_t binding;
+    uint8_t generation;         /* Drops edges queued before the slot was reused */
+    uint8_t level;
+} input_edge_t;
+
+typedef struct {
+    sinricpro_device_handle_t device;   /* NULL = free slot */
+    sinricpro_input_handler_t handler;
+    int gpio_num;
+    bool active_low;
+    int64_t debounce_us;
+    int64_t min_interval_us;
+    uint8_t generation;
+
+    /* Owned by the dispatcher */
+    int level;                  /* Last level reported by the ISR */
+    int64_t level_since_us;     /* Time of the last edge */
+    bool settled;               /* active is valid */
+    bool active;                /* Debounced state */
+    bool sent;                  /* sent_active is valid */
+    bool sent_active;           /* State in the last event sent */
+    int64_t hold_until_us;      /* Rate limit or retry back-off */
+    int64_t backoff_us;
+    uint32_t pending_changes;   /* Settled changes not sent yet */
+    sinricpro_input_stats_t stats;
+
+    atomic_bool overflow;       /* Set by the ISR when the ring was full */
+} input_binding_t;
+
+static struct {
+    bool initialized;
+    SemaphoreHandle_t lock;     /* Binding table; held while handlers run */
+    TaskHandle_t task;
+    input_binding_t bindings[CONFIG_SINRICPRO_INPUT_MAX_BINDINGS];
+
+    /*
+     * Single-producer ring: GPIO ISR service handlers run on the core that
+     * installed the service and do not nest, so only the consumer index is
+     * shared across contexts.
+     */
+    input_edge_t edges[CONFIG_SINRICPRO_INPUT_QUEUE_SIZE];
+    atomic_uint head;           /* Written by the ISR */
+    atomic_uint tail;           /* Written by the dispatcher */
+#if CONFIG_SINRICPRO_STATIC_ALLOCATION
+    StaticSemaphore_t lock_buffer;
+    StaticTask_t task_buffer;
+    StackType_t task_stack[INPUT_TASK_STACK_SIZE / sizeof(StackType_t)];
+#endif
+} input_state;
+
+static void input_isr(void *arg)
+{
+    uint8_t index = (uint8_t)(uintptr_t)arg;
+    input_binding_t *binding = &input_state.bindings[index];
+
+    unsigned head = atomic_load_explicit(&input_state.head, memory_order_relaxed);
+    unsigned tail = atomic_load_explicit(&input_state.tail, memory_order_acquire);
+
+    if (head - tail >= CONFIG_SINRICPRO_INPUT_QUEUE_SIZE) {
+        /* The dispatcher re-reads the level instead */
+        atomic_store_explicit(&binding->overflow, true, memory_order_relaxed);
+    } else {
+        input_edge_t *edge = &input_state.edges[head % CONFIG_SINRICPRO_INPUT_QUEUE_SIZE];
+        edge->time_us = esp_timer_get_time();
+        edge->binding = index;
+        edge->generation = binding->generation;
+        edge->level = (uint8_t)gpio_get_level(binding->gpio_num);
+        atomic_store_explicit(&input_state.head, head + 1, memory_order_release);
+    }
+
+    BaseType_t woken = pdFALSE;
+    vTaskNotifyGiveFromISR(input_state.task, &woken);
+    portYIELD_FROM_ISR(woken);
+}
+
+static void drain_edges(void)
+{
+    unsigned tail = atomic_load_explicit(&input_state.tail, memory_order_relaxed);
+    unsigned head = atomic_load_explicit(&input_state.head, memory_order_acquire);
+
+    while (tail != head) {
+        const input_edge_t *edge = &input_state.edges[tail % CONFIG_SINRICPRO_INPUT_QUEUE_SIZE];
+        input_binding_t *binding = &input_state.bindings[edge->binding];
+
+        if (binding->device != NULL && edge->generation == binding->generation) {
+            binding->level = edge->level;
+            binding->level_since_us = edge->time_us;
+            binding->stats.edges++;
+        }
+        tail++;
+    }
+
+    atomic_store_explicit(&input_state.tail, tail, memory_order_release);
+}
+
+/* Settle, then send if due; returns the time of the next deadline (or INT64_MAX) */
+static int64_t service_binding(input_binding_t *binding, int64_t now)
+{
+    if (atomic_exchange_explicit(&binding->overflow, false, memory_order_relaxed)) {
+        binding->level = gpio_get_level(binding->gpio_num);
+        binding->level_since_us = now;
+        binding->stats.overflows++;
+    }
+
+    int64_t settle_at = binding->level_since_us + binding->debounce_us;
+    if (now < settle_at) {
+        return settle_at;
+    }
+
+    bool active = binding->active_low ? (binding->level == 0) : (binding->level != 0);
+    if (!binding->settled || active != binding->active) {
+        binding->settled = true;
+        binding->active = active;
+
+        if (binding->sent && active == binding->sent_active) {
+            /* Flapped back before it could be sent */
+            binding->stats.coalesced += binding->pending_changes;
+            binding->pending_changes = 0;
+        } else {
+            binding->pending_changes++;
+        }
+    }
+
+    if (binding->sent && binding->active == binding->sent_active) {
+        return INT64_MAX;
+    }
+
+    if (now < binding->hold_until_us) {
+        return binding->hold_until_us;
+    }
+
+    esp_err_t ret = binding->handler(binding->device, binding->active);
+
+    if (ret == ESP_OK) {
+        binding->sent = true;
+        binding->sent_active = binding->active;
+        binding->stats.events++;
+        if (binding->pending_changes > 1) {
+            binding->stats.coalesced += binding->pending_changes - 1;
+        }
+        binding->pending_changes = 0;
+        binding->hold_until_us = now + binding->min_interval_us;
+        binding->backoff_us = 0;
+        return INT64_MAX;
+    }
+
+    if (ret == SINRICPRO_ERR_RATE_LIMITED) {
+        /* Another event of the device used the slot */
+        binding->hold_until_us = now + binding->min_interval_us;
+    } else {
+        /* Offline or not started: keep the state and retry with back-off */
+        binding->backoff_us = binding->backoff_us ? binding->backoff_us * 2 : binding->min_interval_us;
+        if (binding->backoff_us > INPUT_RETRY_MAX_US) {
+            binding->backoff_us = INPUT_RETRY_MAX_US;
+        }
+        binding->hold_until_us = now + binding->backoff_us;
+    }
+
+    return binding->hold_until_us;
+}
+
+static void input_task_func(void *arg)
+{
+    TickType_t wait = portMAX_DELAY;
+
+    while (1) {
+        ulTaskNotifyTake(pdTRUE, wait);
+
+        xSemaphoreTake(input_state.lock, portMAX_DELAY);
+
+        drain_edges();
+
+        int64_t now = esp_timer_get_time();
+        int64_t next = INT64_MAX;
+
+        for (int i = 0; i < CONFIG_SINRICPRO_INPUT_MAX_BINDINGS; i++) {
+            input_binding_t *binding = &input_state.bindings[i];
+            if (binding->device == NULL) {
+                continue;
+            }
+            int64_t deadline = service_binding(binding, now);
+            if (deadline < next) {
+                next = deadline;
+            }
+        }
+
+        xSemaphoreGive(input_state.lock);
+
+        if (next == INT64_MAX) {
+            wait = portMAX_DELAY;
+        } else {
+            /* Round up so the deadline has passed on wake-up */
+            int64_t delay_ms = (next - esp_timer_get_time() + 999) / 1000;
+            wait = delay_ms > 0 ? pdMS_TO_TICKS(delay_ms) + 1 : 1;
+        }
+    }
+}
+
+static esp_err_t input_init(void)
+{
+    if (input_state.initialized) {
+        return ESP_OK;
+    }
+
+#if CONFIG_SINRICPRO_STATIC_ALLOCATION
+    input_state.lock = xSemaphoreCreateMutexStatic(&input_state.lock_buffer);
+#else
+    input_state.lock = xSemaphoreCreateMutex();
+#endif
+    if (input_state.lock == NULL) {
+        ESP_LOGE(TAG, "Failed to create mutex");
+        return ESP_ERR_NO_MEM;
+    }
+
+    /* The application may have installed the service already */
+    esp_err_t ret = gpio_install_isr_service(0);
+    if (ret != ESP_OK && ret != ESP_ERR_INVALID_STATE) {
+        ESP_LOGE(TAG, "Failed to install GPIO ISR service: %s", esp_err_to_name(ret));
+        return ret;
+    }
+
+#if CONFIG_SINRICPRO_STATIC_ALLOCATION
+    input_state.task = xTaskCreateStatic(input_task_func, "sinricpro_input",
+                                         INPUT_TASK_STACK_SIZE / sizeof(StackType_t),
+                                         NULL, 5, input_state.task_stack,
+                                         &input_state.task_buffer);
+    BaseType_t task_ret = input_state.task ? pdPASS : pdFAIL;
+#else
+    BaseType_t task_ret = xTaskCreate(input_task_func, "sinricpro_input",
+                                      INPUT_TASK_STACK_SIZE, NULL, 5, &input_state.task);
+#endif
+    if (task_ret != pdPASS) {
+        ESP_LOGE(TAG, "Failed to create input task");
+        return ESP_FAIL;
+    }
+
+    input_state.initialized = true;
+    return ESP_OK;
+}
+
+static input_binding_t *find_binding(sinricpro_device_handle_t device)
+{
+    for (int i = 0; i < CONFIG_SINRICPRO_INPUT_MAX_BINDINGS; i++) {
+        if (input_state.bindings[i].device == device) {
+            return &input_state.bindings[i];
+        }
+    }
+    return NULL;
+}
+
+esp_err_t sinricpro_input_bind(sinricpro_device_handle_t device,
+                               const sinricpro_input_config_t *config,
+                               uint32_t min_interval_ms,
+                               sinricpro_input_handler_t handler)
+{
+    if (device == NULL || config == NULL || handler == NULL ||
+        !GPIO_IS_VALID_GPIO(config->gpio_num)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    esp_err_t ret = input_init();
+    if (ret != ESP_OK) {
+        return ret;
+    }
+
+    xSemaphoreTake(input_state.lock, portMAX_DELAY);
+
+    if (find_binding(device) != NULL) {
+        xSemaphoreGive(input_state.lock);
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    input_binding_t *binding = find_binding(NULL);
+    if (binding == NULL) {
+        xSemaphoreGive(input_state.lock);
+        ESP_LOGE(TAG, "No free input binding (max %d)", CONFIG_SINRICPRO_INPUT_MAX_BINDINGS);
+        return ESP_ERR_NO_MEM;
+    }
+
+    gpio_config_t io_conf = {
+        .pin_bit_mask = 1ULL << config->gpio_num,
+        .mode = GPIO_MODE_INPUT,
+        .pull_up_en = config->pull_up ? GPIO_PULLUP_ENABLE : GPIO_PULLUP_DISABLE,
+        .pull_down_en = config->pull_down ? GPIO_PULLDOWN_ENABLE : GPIO_PULLDOWN_DISABLE,
+        .intr_type = GPIO_INTR_ANYEDGE,
+    };
+    ret = gpio_config(&io_conf);
+    if (ret != ESP_OK) {
+        xSemaphoreGive(input_state.lock);
+        ESP_LOGE(TAG, "Failed to configure GPIO %d: %s", config->gpio_num, esp_err_to_name(ret));
+        return ret;
+    }
+
+    int64_t now = esp_timer_get_time();
+    uint8_t generation = binding->generation + 1;
+
+    memset(binding, 0, sizeof(*binding));
+    binding->generation = generation;
+    binding->handler = handler;
+    binding->gpio_num = config->gpio_num;
+    binding->active_low = config->active_low;
+    binding->debounce_us = (int64_t)config->debounce_ms * 1000;
+    binding->min_interval_us = (int64_t)min_interval_ms * 1000;
+    binding->level = gpio_get_level(config->gpio_num);
+    binding->level_since_us = now;
+    atomic_init(&binding->overflow, false);
+    binding->device = device;
+
+    uintptr_t index = (uintptr_t)(binding - input_state.bindings);
+    ret = gpio_isr_handler_add(config->gpio_num, input_isr, (void *)index);
+    if (ret != ESP_OK) {
+        binding->device = NULL;
+        xSemaphoreGive(input_state.lock);
+        ESP_LOGE(TAG, "Failed to add ISR for GPIO %d: %s", config->gpio_num, esp_err_to_name(ret));
+        return ret;
+    }
+
+    xSemaphoreGive(input_state.lock);
+
+    /* Report the initial level once it has settled */
+    xTaskNotifyGive(input_state.task);
+
+    ESP_LOGI(TAG, "GPIO %d bound (debounce %lu ms)", config->gpio_num, (unsigned long)config->debounce_ms);
+    return ESP_OK;
+}
+
+void sinricpro_input_unbind(sinricpro_device_handle_t device)
+{
+    if (device == NULL || !input_state.initialized) {
+        return;
+    }
+
+    xSemaphoreTake(input_state.lock, portMAX_DELAY);
+
+    input_binding_t *binding = find_binding(device);
+    if (binding != NULL) {
+        gpio_isr_handler_remove(binding->gpio_num);
+        binding->device = NULL;
+        ESP_LOGI(TAG, "GPIO %d unbound", binding->gpio_num);
+    }
+
+    xSemaphoreGive(input_state.lock);
+}
+
+esp_err_t sinricpro_input_get_stats(sinricpro_device_handle_t device, sinricpro_input_stats_t *stats)
+{
+    if (device == NULL || stats == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    if (!input_state.initialized) {
+        return ESP_ERR_NOT_FOUND;
+    }
+
+    xSemaphoreTake(input_state.lock, portMAX_DELAY);
+
+    input_binding_t *binding = find_binding(device);
+    if (binding != NULL) {
+        *stats = binding->stats;
+    }
+
+    xSemaphoreGive(input_state.lock);
+
+    return binding != NULL ? ESP_OK : ESP_ERR_NOT_FOUND;
+}
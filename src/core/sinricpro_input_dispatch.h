@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) 2019-2025 Sinric. All rights reserved.
+ * Licensed under Creative Commons Attribution-Share Alike (CC BY-SA)
+ *
+ * This file is part of the SinricPro ESP-IDF component
+ * (https://github.com/sinricpro/esp-idf)
+ */
+
+#ifndef SINRICPRO_INPUT_DISPATCH_H
+#define SINRICPRO_INPUT_DISPATCH_H
+
+#include "sinricpro_input.h"
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Send the event for a settled input state (internal)
+ *
+ * Called from the dispatcher task.
+ *
+ * @param[in] device Bound device
+ * @param[in] active true if the input is in its active (detected) state
+ *
+ * @return Result of the device's send function
+ */
+typedef esp_err_t (*sinricpro_input_handler_t)(sinricpro_device_handle_t device, bool active);
+
+/**
+ * @brief Bind a GPIO to a device (internal API)
+ *
+ * The current level is sent once it has been stable for the debounce time.
+ *
+ * @param[in] device          Device (one binding per device)
+ * @param[in] config          GPIO binding
+ * @param[in] min_interval_ms Event rate limit of the device
+ * @param[in] handler         Sends the device's event
+ *
+ * @return
+ *     - ESP_OK: Bound
+ *     - ESP_ERR_INVALID_ARG: Invalid GPIO or config
+ *     - ESP_ERR_INVALID_STATE: Device already bound
+ *     - ESP_ERR_NO_MEM: All CONFIG_SINRICPRO_INPUT_MAX_BINDINGS in use
+ *     - Other error codes from the GPIO driver
+ */
+esp_err_t sinricpro_input_bind(sinricpro_device_handle_t device,
+                               const sinricpro_input_config_t *config,
+                               uint32_t min_interval_ms,
+                               sinricpro_input_handler_t handler);
+
+/**
+ * @brief Remove the binding of a device, if any (internal API)
+ *
+ * After return the handler is no longer called for the device.
+ *
+ * @param[in] device Device
+ */
+void sinricpro_input_unbind(sinricpro_device_handle_t device);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SINRICPRO_INPUT_DISPATCH_H */
@@ -7,22 +7,16 @@
  */
 
 #include "sinricpro_message_queue.h"
+#include "sinricpro_alloc.h"
 #include <stdlib.h>
 #include <string.h>
 #include "esp_log.h"
+#include "cJSON.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/queue.h"
 
 static const char *TAG = "sinricpro_msg_queue";
 
-/**
- * @brief Message queue structure
- */
-struct sinricpro_message_queue {
-    QueueHandle_t queue;
-    size_t max_size;
-};
-
 /**
  * @brief Message structure
  */
@@ -31,6 +25,18 @@ typedef struct {
     size_t length;
 } queue_message_t;
 
+/**
+ * @brief Message queue structure
+ */
+struct sinricpro_message_queue {
+    QueueHandle_t queue;
+    size_t max_size;
+#if CONFIG_SINRICPRO_STATIC_ALLOCATION
+    StaticQueue_t queue_buffer;     /**< Queue control block */
+    queue_message_t *storage;       /**< Queue storage (max_size items) */
+#endif
+};
+
 sinricpro_message_queue_handle_t sinricpro_message_queue_create(size_t max_size)
 {
     if (max_size == 0) {
@@ -38,18 +44,28 @@ sinricpro_message_queue_handle_t sinricpro_message_queue_create(size_t max_size)
         return NULL;
     }
 
-    sinricpro_message_queue_handle_t handle = malloc(sizeof(struct sinricpro_message_queue));
+    sinricpro_message_queue_handle_t handle = sinricpro_malloc(sizeof(struct sinricpro_message_queue));
     if (handle == NULL) {
         ESP_LOGE(TAG, "Failed to allocate message queue handle");
         return NULL;
     }
 
     handle->max_size = max_size;
+#if CONFIG_SINRICPRO_STATIC_ALLOCATION
+    handle->storage = sinricpro_malloc(max_size * sizeof(queue_message_t));
+    handle->queue = handle->storage == NULL ? NULL :
+        xQueueCreateStatic(max_size, sizeof(queue_message_t),
+                           (uint8_t *)handle->storage, &handle->queue_buffer);
+#else
     handle->queue = xQueueCreate(max_size, sizeof(queue_message_t));
+#endif
 
     if (handle->queue == NULL) {
         ESP_LOGE(TAG, "Failed to create FreeRTOS queue");
-        free(handle);
+#if CONFIG_SINRICPRO_STATIC_ALLOCATION
+        sinricpro_free(handle->storage);
+#endif
+        sinricpro_free(handle);
         return NULL;
     }
 
@@ -71,30 +87,41 @@ esp_err_t sinricpro_message_queue_push(sinricpro_message_queue_handle_t handle,
         return SINRICPRO_ERR_QUEUE_FULL;
     }
 
-    /* Allocate and copy message */
+    /* Allocate and copy message (cJSON heap, like the messages handed over by the core) */
     size_t msg_len = strlen(message);
-    char *msg_copy = malloc(msg_len + 1);
+    char *msg_copy = cJSON_malloc(msg_len + 1);
     if (msg_copy == NULL) {
         ESP_LOGE(TAG, "Failed to allocate message buffer");
         return SINRICPRO_ERR_NO_MEMORY;
     }
 
-    strcpy(msg_copy, message);
+    memcpy(msg_copy, message, msg_len + 1);
+
+    return sinricpro_message_queue_push_owned(handle, msg_copy);
+}
+
+esp_err_t sinricpro_message_queue_push_owned(sinricpro_message_queue_handle_t handle,
+                                              char *message)
+{
+    if (handle == NULL || message == NULL) {
+        cJSON_free(message);
+        return ESP_ERR_INVALID_ARG;
+    }
 
     queue_message_t queue_msg = {
-        .message = msg_copy,
-        .length = msg_len
+        .message = message,
+        .length = strlen(message)
     };
 
     /* Push to queue */
     if (xQueueSend(handle->queue, &queue_msg, 0) != pdTRUE) {
-        ESP_LOGE(TAG, "Failed to push message to queue");
-        free(msg_copy);
-        return ESP_FAIL;
+        ESP_LOGW(TAG, "Message queue is full, dropping message");
+        cJSON_free(message);
+        return SINRICPRO_ERR_QUEUE_FULL;
     }
 
     ESP_LOGD(TAG, "Message pushed to queue (len=%zu, queue_size=%d)",
-             msg_len, uxQueueMessagesWaiting(handle->queue));
+             queue_msg.length, uxQueueMessagesWaiting(handle->queue));
 
     return ESP_OK;
 }
@@ -124,7 +151,7 @@ esp_err_t sinricpro_message_queue_pop(sinricpro_message_queue_handle_t handle,
 void sinricpro_message_queue_free_message(char *message)
 {
     if (message != NULL) {
-        free(message);
+        cJSON_free(message);
     }
 }
 
@@ -161,7 +188,7 @@ void sinricpro_message_queue_clear(sinricpro_message_queue_handle_t handle)
 
     /* Pop and free all messages */
     while (xQueueReceive(handle->queue, &queue_msg, 0) == pdTRUE) {
-        free(queue_msg.message);
+        cJSON_free(queue_msg.message);
     }
 
     ESP_LOGD(TAG, "Message queue cleared");
@@ -180,7 +207,10 @@ void sinricpro_message_queue_destroy(sinricpro_message_queue_handle_t handle)
     vQueueDelete(handle->queue);
 
     /* Free handle */
-    free(handle);
+#if CONFIG_SINRICPRO_STATIC_ALLOCATION
+    sinricpro_free(handle->storage);
+#endif
+    sinricpro_free(handle);
 
     ESP_LOGI(TAG, "Message queue destroyed");
 }
@@ -50,6 +50,24 @@ sinricpro_message_queue_handle_t sinricpro_message_queue_create(size_t max_size)
 esp_err_t sinricpro_message_queue_push(sinricpro_message_queue_handle_t handle,
                                         const char *message);
 
+/**
+ * @brief Push a message to the queue, taking ownership of it
+ *
+ * Avoids the copy made by sinricpro_message_queue_push(). The message must
+ * have been allocated by cJSON (e.g., cJSON_PrintBuffered()); on failure it
+ * is freed before returning.
+ *
+ * @param[in] handle  Queue handle
+ * @param[in] message Message string to push
+ *
+ * @return
+ *     - ESP_OK: Success
+ *     - ESP_ERR_INVALID_ARG: Invalid arguments
+ *     - SINRICPRO_ERR_QUEUE_FULL: Queue is full
+ */
+esp_err_t sinricpro_message_queue_push_owned(sinricpro_message_queue_handle_t handle,
+                                              char *message);
+
 /**
  * @brief Pop a message from the queue
  *
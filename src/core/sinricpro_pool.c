@@ -0,0 +1,310 @@
+/*
+ * Copyright (c) 2019-2025 Sinric. All rights reserved.
+ * Licensed under Creative Commons Attribution-Share Alike (CC BY-SA)
+ *
+ * This file is part of the SinricPro ESP-IDF component
+ * (https://github.com/sinricpro/esp-idf)
+ */
+
+#include "sinricpro_alloc.h"
+#include "sinricpro_static.h"
+#include <string.h>
+#include "esp_log.h"
+#include "esp_heap_caps.h"
+#include "cJSON.h"
+#include "freertos/FreeRTOS.h"
+
+static const char *TAG = "sinricpro_pool";
+
+#define POOL_SMALL_BLOCK    64      /* Fits a cJSON node and most keys/values */
+#define POOL_MEDIUM_BLOCK   512     /* Fits a printed response or event */
+#define POOL_LARGE_BLOCK    CONFIG_SINRICPRO_STATIC_LARGE_BLOCK_SIZE
+#define POOL_ALIGN          16
+#define ARENA_ALIGN         8
+
+/**
+ * @brief Free block (the link lives in the block itself)
+ */
+typedef struct pool_block {
+    struct pool_block *next;
+} pool_block_t;
+
+/**
+ * @brief Fixed-size block pool
+ */
+typedef struct {
+    uint8_t *base;
+    size_t block_size;
+    uint32_t blocks;
+    pool_block_t *free_list;
+    uint32_t in_use;
+    uint32_t peak;
+    uint32_t failures;
+} pool_t;
+
+static uint8_t small_storage[CONFIG_SINRICPRO_STATIC_SMALL_BLOCKS][POOL_SMALL_BLOCK]
+    __attribute__((aligned(POOL_ALIGN)));
+static uint8_t medium_storage[CONFIG_SINRICPRO_STATIC_MEDIUM_BLOCKS][POOL_MEDIUM_BLOCK]
+    __attribute__((aligned(POOL_ALIGN)));
+static uint8_t large_storage[CONFIG_SINRICPRO_STATIC_LARGE_BLOCKS][POOL_LARGE_BLOCK]
+    __attribute__((aligned(POOL_ALIGN)));
+static uint8_t arena_storage[CONFIG_SINRICPRO_STATIC_ARENA_SIZE]
+    __attribute__((aligned(POOL_ALIGN)));
+
+#define POOL_COUNT 3
+
+/**
+ * @brief Static memory state
+ */
+static struct {
+    pool_t pools[POOL_COUNT];   /* Ordered by block size */
+    size_t arena_used;
+    bool initialized;
+    portMUX_TYPE lock;
+} pool_state = {
+    .pools = {
+        { (uint8_t *)small_storage, POOL_SMALL_BLOCK, CONFIG_SINRICPRO_STATIC_SMALL_BLOCKS },
+        { (uint8_t *)medium_storage, POOL_MEDIUM_BLOCK, CONFIG_SINRICPRO_STATIC_MEDIUM_BLOCKS },
+        { (uint8_t *)large_storage, POOL_LARGE_BLOCK, CONFIG_SINRICPRO_STATIC_LARGE_BLOCKS },
+    },
+    .lock = portMUX_INITIALIZER_UNLOCKED,
+};
+
+/* Called with the lock held */
+static void pools_init(void)
+{
+    for (int p = 0; p < POOL_COUNT; p++) {
+        pool_t *pool = &pool_state.pools[p];
+        pool->free_list = NULL;
+        for (uint32_t i = pool->blocks; i > 0; i--) {
+            pool_block_t *block = (pool_block_t *)(pool->base + (i - 1) * pool->block_size);
+            block->next = pool->free_list;
+            pool->free_list = block;
+        }
+    }
+    pool_state.initialized = true;
+}
+
+static pool_t *pool_of(const void *ptr)
+{
+    for (int p = 0; p < POOL_COUNT; p++) {
+        pool_t *pool = &pool_state.pools[p];
+        const uint8_t *byte = (const uint8_t *)ptr;
+        if (byte >= pool->base && byte < pool->base + pool->blocks * pool->block_size) {
+            return pool;
+        }
+    }
+
+    return NULL;
+}
+
+void *sinricpro_pool_malloc(size_t size)
+{
+    pool_block_t *block = NULL;
+    pool_t *fitting = NULL;
+
+    if (size == 0) {
+        size = 1;
+    }
+
+    portENTER_CRITICAL(&pool_state.lock);
+
+    if (!pool_state.initialized) {
+        pools_init();
+    }
+
+    /* Smallest class that fits and has a free block */
+    for (int p = 0; p < POOL_COUNT && block == NULL; p++) {
+        pool_t *pool = &pool_state.pools[p];
+        if (size > pool->block_size) {
+            continue;
+        }
+        if (fitting == NULL) {
+            fitting = pool;
+        }
+        if (pool->free_list) {
+            block = pool->free_list;
+            pool->free_list = block->next;
+            pool->in_use++;
+            if (pool->in_use > pool->peak) {
+                pool->peak = pool->in_use;
+            }
+        }
+    }
+
+    if (block == NULL && fitting != NULL) {
+        fitting->failures++;
+    }
+
+    portEXIT_CRITICAL(&pool_state.lock);
+
+    if (block == NULL) {
+        ESP_LOGE(TAG, "No free block for %zu bytes", size);
+    }
+
+    return block;
+}
+
+void *sinricpro_pool_calloc(size_t count, size_t size)
+{
+    if (size != 0 && count > SIZE_MAX / size) {
+        return NULL;
+    }
+
+    void *ptr = sinricpro_pool_malloc(count * size);
+    if (ptr) {
+        memset(ptr, 0, count * size);
+    }
+
+    return ptr;
+}
+
+void sinricpro_pool_free(void *ptr)
+{
+    if (ptr == NULL) {
+        return;
+    }
+
+    pool_t *pool = pool_of(ptr);
+    if (pool == NULL) {
+        /* Allocated by cJSON before the hooks were installed */
+        free(ptr);
+        return;
+    }
+
+    portENTER_CRITICAL(&pool_state.lock);
+    pool_block_t *block = (pool_block_t *)ptr;
+    block->next = pool->free_list;
+    pool->free_list = block;
+    pool->in_use--;
+    portEXIT_CRITICAL(&pool_state.lock);
+}
+
+size_t sinricpro_pool_block_size(void *ptr)
+{
+    pool_t *pool = pool_of(ptr);
+    if (pool == NULL) {
+        return heap_caps_get_allocated_size(ptr);
+    }
+
+    return pool->block_size;
+}
+
+void *sinricpro_pool_realloc(void *ptr, size_t size)
+{
+    if (ptr == NULL) {
+        return sinricpro_pool_malloc(size);
+    }
+
+    size_t current = sinricpro_pool_block_size(ptr);
+    if (size <= current && pool_of(ptr) != NULL) {
+        return ptr;
+    }
+
+    void *result = sinricpro_pool_malloc(size);
+    if (result) {
+        memcpy(result, ptr, current < size ? current : size);
+        sinricpro_pool_free(ptr);
+    }
+
+    return result;
+}
+
+char *sinricpro_pool_strdup(const char *str)
+{
+    size_t length = strlen(str) + 1;
+    char *copy = sinricpro_pool_malloc(length);
+    if (copy) {
+        memcpy(copy, str, length);
+    }
+
+    return copy;
+}
+
+void *sinricpro_object_alloc(size_t size)
+{
+    void *ptr = NULL;
+    size_t aligned = (size + ARENA_ALIGN - 1) & ~(size_t)(ARENA_ALIGN - 1);
+
+    portENTER_CRITICAL(&pool_state.lock);
+    if (aligned <= sizeof(arena_storage) - pool_state.arena_used) {
+        ptr = &arena_storage[pool_state.arena_used];
+        pool_state.arena_used += aligned;
+    }
+    portEXIT_CRITICAL(&pool_state.lock);
+
+    if (ptr == NULL) {
+        ESP_LOGE(TAG, "Object arena exhausted (%zu of %zu bytes used, %zu requested)",
+                 pool_state.arena_used, sizeof(arena_storage), size);
+    }
+
+    return ptr;
+}
+
+void sinricpro_object_free(void *ptr)
+{
+    const uint8_t *byte = (const uint8_t *)ptr;
+
+    if (byte >= arena_storage && byte < arena_storage + sizeof(arena_storage)) {
+        ESP_LOGD(TAG, "Object released; arena space is not reused");
+        return;
+    }
+
+    free(ptr);
+}
+
+#if !CONFIG_SINRICPRO_ALLOC_STATS
+void sinricpro_alloc_install_hooks(void)
+{
+    /* Without libc hooks cJSON never calls realloc */
+    cJSON_Hooks hooks = {
+        .malloc_fn = sinricpro_pool_malloc,
+        .free_fn = sinricpro_pool_free,
+    };
+    cJSON_InitHooks(&hooks);
+}
+#endif
+
+static void pool_usage(const pool_t *pool, sinricpro_static_pool_usage_t *usage)
+{
+    usage->block_size = pool->block_size;
+    usage->blocks = pool->blocks;
+    usage->in_use = pool->in_use;
+    usage->peak = pool->peak;
+    usage->failures = pool->failures;
+}
+
+esp_err_t sinricpro_static_get_usage(sinricpro_static_usage_t *usage)
+{
+    if (usage == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    portENTER_CRITICAL(&pool_state.lock);
+    usage->arena_size = sizeof(arena_storage);
+    usage->arena_used = pool_state.arena_used;
+    pool_usage(&pool_state.pools[0], &usage->small);
+    pool_usage(&pool_state.pools[1], &usage->medium);
+    pool_usage(&pool_state.pools[2], &usage->large);
+    portEXIT_CRITICAL(&pool_state.lock);
+
+    return ESP_OK;
+}
+
+void sinricpro_static_log_usage(void)
+{
+    sinricpro_static_usage_t usage;
+    sinricpro_static_get_usage(&usage);
+
+    ESP_LOGI(TAG, "Arena: %zu/%zu bytes", usage.arena_used, usage.arena_size);
+
+    const sinricpro_static_pool_usage_t *pools[] = { &usage.small, &usage.medium, &usage.large };
+    for (int p = 0; p < POOL_COUNT; p++) {
+        ESP_LOGI(TAG, "Pool %4zu B: %lu/%lu in use, peak %lu, failures %lu",
+                 pools[p]->block_size,
+                 (unsigned long)pools[p]->in_use,
+                 (unsigned long)pools[p]->blocks,
+                 (unsigned long)pools[p]->peak,
+                 (unsigned long)pools[p]->failures);
+    }
+}
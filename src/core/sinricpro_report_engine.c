@@ -0,0 +1,282 @@
+/*
+ * Copyright (c) 2019-2025 Sinric. All rights reserved.
+ * Licensed under Creative Commons Attribution-Share Alike (CC BY-SA)
+ *
+ * This file is part of the SinricPro ESP-IDF component
+ * (https://github.com/sinricpro/esp-idf)
+ */
+
+#include "sinricpro_report_engine.h"
+#include "sinricpro_alloc.h"
+#include <string.h>
+#include <math.h>
+#include "esp_log.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+static const char *TAG = "sinricpro_report";
+
+#define P2_MARKERS 5
+
+/**
+ * @brief Running summary of one reading
+ *
+ * The median uses the P-square algorithm (Jain and Chlamtac, 1985): five
+ * markers track the minimum, the quartiles, the median and the maximum,
+ * and are moved with piecewise-parabolic interpolation as samples arrive.
+ */
+typedef struct {
+    double sum;
+    float min;
+    float max;
+    float last;
+    float reported;             /**< Value sent in the last report */
+    float q[P2_MARKERS];        /**< Marker heights (first five samples, sorted) */
+    int32_t n[P2_MARKERS];      /**< Marker positions, 1-based */
+} report_channel_t;
+
+struct sinricpro_report {
+    sinricpro_report_policy_t policy;
+    uint32_t count;             /**< Samples in the window */
+    TickType_t last_attempt;    /**< Tick count of the last report attempt */
+    bool reported;              /**< A report has been sent */
+    bool attempted;             /**< A report has been attempted */
+    uint8_t channels;
+    report_channel_t channel[];
+};
+
+/* Desired marker positions advance by these fractions of each sample (p = 0.5) */
+static const float p2_increment[P2_MARKERS] = { 0.0f, 0.25f, 0.5f, 0.75f, 1.0f };
+
+static void window_reset(sinricpro_report_handle_t handle)
+{
+    handle->count = 0;
+
+    for (int c = 0; c < handle->channels; c++) {
+        report_channel_t *ch = &handle->channel[c];
+        ch->sum = 0;
+        ch->min = INFINITY;
+        ch->max = -INFINITY;
+    }
+}
+
+static float p2_parabolic(const report_channel_t *ch, int i, int d)
+{
+    float n_lo = ch->n[i - 1], n_i = ch->n[i], n_hi = ch->n[i + 1];
+
+    return ch->q[i] + d / (n_hi - n_lo) *
+           ((n_i - n_lo + d) * (ch->q[i + 1] - ch->q[i]) / (n_hi - n_i) +
+            (n_hi - n_i - d) * (ch->q[i] - ch->q[i - 1]) / (n_i - n_lo));
+}
+
+static void p2_add(report_channel_t *ch, uint32_t count, float x)
+{
+    /* count includes x */
+    if (count <= P2_MARKERS) {
+        /* Insertion sort of the first five samples */
+        int i = (int)count - 1;
+        while (i > 0 && ch->q[i - 1] > x) {
+            ch->q[i] = ch->q[i - 1];
+            i--;
+        }
+        ch->q[i] = x;
+        ch->n[count - 1] = (int32_t)count;
+        return;
+    }
+
+    int k;
+    if (x < ch->q[0]) {
+        ch->q[0] = x;
+        k = 0;
+    } else if (x >= ch->q[P2_MARKERS - 1]) {
+        ch->q[P2_MARKERS - 1] = x;
+        k = P2_MARKERS - 2;
+    } else {
+        k = 0;
+        while (x >= ch->q[k + 1]) {
+            k++;
+        }
+    }
+
+    for (int i = k + 1; i < P2_MARKERS; i++) {
+        ch->n[i]++;
+    }
+
+    for (int i = 1; i < P2_MARKERS - 1; i++) {
+        float desired = 1.0f + (count - 1) * p2_increment[i];
+        float offset = desired - ch->n[i];
+
+        if ((offset >= 1.0f && ch->n[i + 1] - ch->n[i] > 1) ||
+            (offset <= -1.0f && ch->n[i - 1] - ch->n[i] < -1)) {
+            int d = offset > 0 ? 1 : -1;
+            float q = p2_parabolic(ch, i, d);
+            if (ch->q[i - 1] < q && q < ch->q[i + 1]) {
+                ch->q[i] = q;
+            } else {
+                ch->q[i] += d * (ch->q[i + d] - ch->q[i]) / (ch->n[i + d] - ch->n[i]);
+            }
+            ch->n[i] += d;
+        }
+    }
+}
+
+static float p2_median(const report_channel_t *ch, uint32_t count)
+{
+    if (count >= P2_MARKERS) {
+        return ch->q[2];
+    }
+
+    /* Exact median of the sorted samples */
+    return (count % 2) ? ch->q[count / 2] : (ch->q[count / 2 - 1] + ch->q[count / 2]) / 2.0f;
+}
+
+static float channel_value(const sinricpro_report_handle_t handle, const report_channel_t *ch)
+{
+    switch (handle->policy.aggregate) {
+    case SINRICPRO_REPORT_MEAN:
+        return (float)(ch->sum / handle->count);
+    case SINRICPRO_REPORT_MIN:
+        return ch->min;
+    case SINRICPRO_REPORT_MAX:
+        return ch->max;
+    case SINRICPRO_REPORT_MEDIAN:
+        return p2_median(ch, handle->count);
+    default:
+        return ch->last;
+    }
+}
+
+static bool channel_changed(const sinricpro_report_policy_t *policy, float value, float reported)
+{
+    float change = fabsf(value - reported);
+
+    if (policy->absolute_threshold <= 0.0f && policy->relative_threshold <= 0.0f) {
+        return change > 0.0f;
+    }
+
+    return (policy->absolute_threshold > 0.0f && change >= policy->absolute_threshold) ||
+           (policy->relative_threshold > 0.0f &&
+            change >= policy->relative_threshold * fabsf(reported));
+}
+
+esp_err_t sinricpro_report_configure(sinricpro_report_handle_t *handle,
+                                     uint8_t channels,
+                                     const sinricpro_report_policy_t *policy,
+                                     uint32_t min_interval_ms)
+{
+    if (handle == NULL || policy == NULL || channels == 0 ||
+        channels > SINRICPRO_REPORT_MAX_CHANNELS ||
+        policy->aggregate > SINRICPRO_REPORT_MEDIAN) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    if (*handle == NULL) {
+        size_t size = sizeof(struct sinricpro_report) + channels * sizeof(report_channel_t);
+        sinricpro_report_handle_t report = sinricpro_object_alloc(size);
+        if (report == NULL) {
+            ESP_LOGE(TAG, "Failed to allocate report engine");
+            return ESP_ERR_NO_MEM;
+        }
+        memset(report, 0, size);
+        report->channels = channels;
+        *handle = report;
+    } else if ((*handle)->channels != channels) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    sinricpro_report_handle_t report = *handle;
+    report->policy = *policy;
+
+    if (report->policy.min_interval_ms < min_interval_ms) {
+        ESP_LOGW(TAG, "min_interval_ms raised from %lu to %lu ms",
+                 (unsigned long)report->policy.min_interval_ms, (unsigned long)min_interval_ms);
+        report->policy.min_interval_ms = min_interval_ms;
+    }
+
+    window_reset(report);
+
+    return ESP_OK;
+}
+
+sinricpro_report_due_t sinricpro_report_push(sinricpro_report_handle_t handle,
+                                             const float *samples,
+                                             float *values)
+{
+    if (handle == NULL || samples == NULL || values == NULL) {
+        return SINRICPRO_REPORT_NOT_DUE;
+    }
+
+    handle->count++;
+
+    for (int c = 0; c < handle->channels; c++) {
+        report_channel_t *ch = &handle->channel[c];
+        float x = samples[c];
+
+        ch->sum += x;
+        ch->last = x;
+        if (x < ch->min) {
+            ch->min = x;
+        }
+        if (x > ch->max) {
+            ch->max = x;
+        }
+        if (handle->policy.aggregate == SINRICPRO_REPORT_MEDIAN) {
+            p2_add(ch, handle->count, x);
+        }
+    }
+
+    /* Measured in ticks like the event limiter, so a due report is not limited */
+    uint32_t elapsed_ms = UINT32_MAX;
+    if (handle->attempted) {
+        TickType_t ticks_elapsed = xTaskGetTickCount() - handle->last_attempt;
+        elapsed_ms = (uint32_t)(((uint64_t)ticks_elapsed * 1000) / configTICK_RATE_HZ);
+    }
+
+    if (elapsed_ms < handle->policy.min_interval_ms) {
+        return SINRICPRO_REPORT_NOT_DUE;
+    }
+
+    bool changed = !handle->reported;
+
+    for (int c = 0; c < handle->channels; c++) {
+        const report_channel_t *ch = &handle->channel[c];
+        values[c] = channel_value(handle, ch);
+        changed = changed || channel_changed(&handle->policy, values[c], ch->reported);
+    }
+
+    if (changed) {
+        return SINRICPRO_REPORT_CHANGED;
+    }
+
+    if (handle->policy.max_interval_ms > 0 && elapsed_ms >= handle->policy.max_interval_ms) {
+        return SINRICPRO_REPORT_HEARTBEAT;
+    }
+
+    return SINRICPRO_REPORT_NOT_DUE;
+}
+
+void sinricpro_report_done(sinricpro_report_handle_t handle, const float *values, bool sent)
+{
+    if (handle == NULL) {
+        return;
+    }
+
+    handle->last_attempt = xTaskGetTickCount();
+    handle->attempted = true;
+
+    if (!sent) {
+        return;
+    }
+
+    for (int c = 0; c < handle->channels; c++) {
+        handle->channel[c].reported = values[c];
+    }
+    handle->reported = true;
+
+    window_reset(handle);
+}
+
+void sinricpro_report_destroy(sinricpro_report_handle_t handle)
+{
+    sinricpro_object_free(handle);
+}
@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2019-2025 Sinric. All rights reserved.
+ * Licensed under Creative Commons Attribution-Share Alike (CC BY-SA)
+ *
+ * This file is part of the SinricPro ESP-IDF component
+ * (https://github.com/sinricpro/esp-idf)
+ */
+
+#ifndef SINRICPRO_REPORT_ENGINE_H
+#define SINRICPRO_REPORT_ENGINE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "sinricpro_report.h"
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Report engine handle (opaque)
+ *
+ * Folds the samples of up to SINRICPRO_REPORT_MAX_CHANNELS readings (e.g.
+ * temperature and humidity) and decides when a sensor reports. Not thread
+ * safe: push samples for one sensor from one task.
+ */
+typedef struct sinricpro_report* sinricpro_report_handle_t;
+
+#define SINRICPRO_REPORT_MAX_CHANNELS 6
+
+/**
+ * @brief Why a report is due
+ */
+typedef enum {
+    SINRICPRO_REPORT_NOT_DUE = 0,
+    SINRICPRO_REPORT_CHANGED,       /**< A reading crossed a threshold (or first report) */
+    SINRICPRO_REPORT_HEARTBEAT,     /**< max_interval_ms passed without a change */
+} sinricpro_report_due_t;
+
+/**
+ * @brief Create an engine or apply a new policy to an existing one
+ *
+ * The window is restarted; the value last reported is kept.
+ *
+ * @param[in,out] handle          Engine (created if *handle is NULL)
+ * @param[in]     channels        Readings per sample
+ * @param[in]     policy          Policy
+ * @param[in]     min_interval_ms Lower bound for policy->min_interval_ms
+ *
+ * @return ESP_OK, ESP_ERR_INVALID_ARG or ESP_ERR_NO_MEM
+ */
+esp_err_t sinricpro_report_configure(sinricpro_report_handle_t *handle,
+                                     uint8_t channels,
+                                     const sinricpro_report_policy_t *policy,
+                                     uint32_t min_interval_ms);
+
+/**
+ * @brief Add a sample and check whether a report is due
+ *
+ * @param[in]  handle  Engine
+ * @param[in]  samples One value per channel
+ * @param[out] values  Summary of the window per channel, valid when a
+ *                     report is due
+ *
+ * @return Whether and why a report is due
+ */
+sinricpro_report_due_t sinricpro_report_push(sinricpro_report_handle_t handle,
+                                             const float *samples,
+                                             float *values);
+
+/**
+ * @brief Record the outcome of a report
+ *
+ * A sent report starts a new window. A failed one keeps the window and is
+ * retried after min_interval_ms.
+ *
+ * @param[in] handle Engine
+ * @param[in] values Values reported
+ * @param[in] sent   true if the report was queued
+ */
+void sinricpro_report_done(sinricpro_report_handle_t handle, const float *values, bool sent);
+
+/**
+ * @brief Destroy an engine
+ *
+ * @param[in] handle Engine (can be NULL)
+ */
+void sinricpro_report_destroy(sinricpro_report_handle_t handle);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SINRICPRO_REPORT_ENGINE_H */
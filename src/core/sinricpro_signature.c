@@ -8,12 +8,88 @@
 
 #include "sinricpro_signature.h"
 #include <string.h>
-#include "mbedtls/md.h"
+#include "mbedtls/sha256.h"
 #include "mbedtls/base64.h"
+#include "mbedtls/version.h"
 #include "esp_log.h"
 
 static const char *TAG = "sinricpro_signature";
 
+/* mbedtls 3.x dropped the _ret suffix (ESP-IDF 5.0 and later) */
+#if MBEDTLS_VERSION_NUMBER >= 0x03000000
+#define sha256_starts(ctx)              mbedtls_sha256_starts((ctx), 0)
+#define sha256_update(ctx, data, len)   mbedtls_sha256_update((ctx), (data), (len))
+#define sha256_finish(ctx, out)         mbedtls_sha256_finish((ctx), (out))
+#else
+#define sha256_starts(ctx)              mbedtls_sha256_starts_ret((ctx), 0)
+#define sha256_update(ctx, data, len)   mbedtls_sha256_update_ret((ctx), (data), (len))
+#define sha256_finish(ctx, out)         mbedtls_sha256_finish_ret((ctx), (out))
+#endif
+
+#define SHA256_BLOCK_SIZE  64
+#define SHA256_DIGEST_SIZE 32
+
+/**
+ * @brief HMAC-SHA256 (RFC 2104) on a stack context
+ *
+ * mbedtls_md_setup() allocates the HMAC context on the heap for every call;
+ * this keeps signing and verification off the heap.
+ */
+static int hmac_sha256(const unsigned char *key, size_t key_len,
+                       const unsigned char *data, size_t data_len,
+                       unsigned char out[SHA256_DIGEST_SIZE])
+{
+    unsigned char pad[SHA256_BLOCK_SIZE];
+    unsigned char key_digest[SHA256_DIGEST_SIZE];
+    unsigned char inner[SHA256_DIGEST_SIZE];
+    mbedtls_sha256_context ctx;
+    int ret;
+
+    mbedtls_sha256_init(&ctx);
+
+    /* Keys longer than a block are hashed first */
+    if (key_len > SHA256_BLOCK_SIZE) {
+        if ((ret = sha256_starts(&ctx)) != 0 ||
+            (ret = sha256_update(&ctx, key, key_len)) != 0 ||
+            (ret = sha256_finish(&ctx, key_digest)) != 0) {
+            goto exit;
+        }
+        key = key_digest;
+        key_len = SHA256_DIGEST_SIZE;
+    }
+
+    /* inner = H((K ^ ipad) || data) */
+    memset(pad, 0x36, sizeof(pad));
+    for (size_t i = 0; i < key_len; i++) {
+        pad[i] ^= key[i];
+    }
+    if ((ret = sha256_starts(&ctx)) != 0 ||
+        (ret = sha256_update(&ctx, pad, sizeof(pad))) != 0 ||
+        (ret = sha256_update(&ctx, data, data_len)) != 0 ||
+        (ret = sha256_finish(&ctx, inner)) != 0) {
+        goto exit;
+    }
+
+    /* out = H((K ^ opad) || inner) */
+    memset(pad, 0x5c, sizeof(pad));
+    for (size_t i = 0; i < key_len; i++) {
+        pad[i] ^= key[i];
+    }
+    if ((ret = sha256_starts(&ctx)) != 0 ||
+        (ret = sha256_update(&ctx, pad, sizeof(pad))) != 0 ||
+        (ret = sha256_update(&ctx, inner, sizeof(inner))) != 0 ||
+        (ret = sha256_finish(&ctx, out)) != 0) {
+        goto exit;
+    }
+
+exit:
+    mbedtls_sha256_free(&ctx);
+    memset(pad, 0, sizeof(pad));
+    memset(key_digest, 0, sizeof(key_digest));
+
+    return ret;
+}
+
 /**
  * @brief Calculate HMAC-SHA256 signature and encode as base64
  *
@@ -37,45 +113,18 @@ esp_err_t sinricpro_calculate_signature(const char *secret,
         return ESP_ERR_INVALID_ARG;
     }
 
-    unsigned char hmac_result[32];  /* SHA256 produces 32 bytes */
+    unsigned char hmac_result[SHA256_DIGEST_SIZE];
     size_t olen = 0;
 
     /* Calculate HMAC-SHA256 */
-    mbedtls_md_context_t ctx;
-    mbedtls_md_type_t md_type = MBEDTLS_MD_SHA256;
-
-    mbedtls_md_init(&ctx);
-
-    int ret = mbedtls_md_setup(&ctx, mbedtls_md_info_from_type(md_type), 1);
-    if (ret != 0) {
-        ESP_LOGE(TAG, "mbedtls_md_setup failed: %d", ret);
-        mbedtls_md_free(&ctx);
-        return ESP_FAIL;
-    }
-
-    ret = mbedtls_md_hmac_starts(&ctx, (const unsigned char *)secret, strlen(secret));
-    if (ret != 0) {
-        ESP_LOGE(TAG, "mbedtls_md_hmac_starts failed: %d", ret);
-        mbedtls_md_free(&ctx);
-        return ESP_FAIL;
-    }
-
-    ret = mbedtls_md_hmac_update(&ctx, (const unsigned char *)payload, strlen(payload));
+    int ret = hmac_sha256((const unsigned char *)secret, strlen(secret),
+                          (const unsigned char *)payload, strlen(payload),
+                          hmac_result);
     if (ret != 0) {
-        ESP_LOGE(TAG, "mbedtls_md_hmac_update failed: %d", ret);
-        mbedtls_md_free(&ctx);
+        ESP_LOGE(TAG, "HMAC-SHA256 failed: %d", ret);
         return ESP_FAIL;
     }
 
-    ret = mbedtls_md_hmac_finish(&ctx, hmac_result);
-    if (ret != 0) {
-        ESP_LOGE(TAG, "mbedtls_md_hmac_finish failed: %d", ret);
-        mbedtls_md_free(&ctx);
-        return ESP_FAIL;
-    }
-
-    mbedtls_md_free(&ctx);
-
     /* Encode to base64 */
     ret = mbedtls_base64_encode((unsigned char *)signature, sig_len, &olen,
                                  hmac_result, sizeof(hmac_result));
@@ -136,47 +185,44 @@ esp_err_t sinricpro_verify_signature(const char *secret,
 }
 
 /**
- * @brief Extract payload string from JSON message
- *
- * Extracts the "payload" field from a JSON message string for signature
- * calculation/verification.
+ * @brief Locate the payload object in a JSON message
  *
  * @param[in]  json_message  Complete JSON message string
- * @param[out] payload       Output buffer for extracted payload
- * @param[in]  payload_len   Size of payload buffer
+ * @param[out] payload_start First character of the payload object ('{')
+ * @param[out] payload_size  Length of the payload object, braces included
  *
  * @return
  *     - ESP_OK: Success
  *     - ESP_ERR_INVALID_ARG: Invalid arguments
- *     - ESP_FAIL: Failed to extract payload
+ *     - ESP_FAIL: Payload not found
  */
-esp_err_t sinricpro_extract_payload(const char *json_message,
-                                     char *payload,
-                                     size_t payload_len)
+esp_err_t sinricpro_find_payload(const char *json_message,
+                                  const char **payload_start,
+                                  size_t *payload_size)
 {
-    if (json_message == NULL || payload == NULL || payload_len == 0) {
+    if (json_message == NULL || payload_start == NULL || payload_size == NULL) {
         ESP_LOGE(TAG, "Invalid arguments");
         return ESP_ERR_INVALID_ARG;
     }
 
     /* Find "payload" field in JSON */
-    const char *payload_start = strstr(json_message, "\"payload\":");
-    if (payload_start == NULL) {
+    const char *start = strstr(json_message, "\"payload\":");
+    if (start == NULL) {
         ESP_LOGE(TAG, "\"payload\" field not found in JSON");
         return ESP_FAIL;
     }
 
     /* Skip to the start of the payload object */
-    payload_start = strchr(payload_start, '{');
-    if (payload_start == NULL) {
+    start = strchr(start, '{');
+    if (start == NULL) {
         ESP_LOGE(TAG, "Payload object not found");
         return ESP_FAIL;
     }
 
     /* Find the end of the payload object by matching braces */
     int brace_count = 0;
-    const char *p = payload_start;
-    const char *payload_end = NULL;
+    const char *p = start;
+    const char *end = NULL;
 
     while (*p != '\0') {
         if (*p == '{') {
@@ -184,19 +230,55 @@ esp_err_t sinricpro_extract_payload(const char *json_message,
         } else if (*p == '}') {
             brace_count--;
             if (brace_count == 0) {
-                payload_end = p + 1;  /* Include closing brace */
+                end = p + 1;  /* Include closing brace */
                 break;
             }
         }
         p++;
     }
 
-    if (payload_end == NULL) {
+    if (end == NULL) {
         ESP_LOGE(TAG, "Payload object end not found");
         return ESP_FAIL;
     }
 
-    size_t payload_size = payload_end - payload_start;
+    *payload_start = start;
+    *payload_size = end - start;
+
+    return ESP_OK;
+}
+
+/**
+ * @brief Extract payload string from JSON message
+ *
+ * Extracts the "payload" field from a JSON message string for signature
+ * calculation/verification.
+ *
+ * @param[in]  json_message  Complete JSON message string
+ * @param[out] payload       Output buffer for extracted payload
+ * @param[in]  payload_len   Size of payload buffer
+ *
+ * @return
+ *     - ESP_OK: Success
+ *     - ESP_ERR_INVALID_ARG: Invalid arguments
+ *     - ESP_FAIL: Failed to extract payload
+ */
+esp_err_t sinricpro_extract_payload(const char *json_message,
+                                     char *payload,
+                                     size_t payload_len)
+{
+    if (json_message == NULL || payload == NULL || payload_len == 0) {
+        ESP_LOGE(TAG, "Invalid arguments");
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    const char *payload_start = NULL;
+    size_t payload_size = 0;
+
+    esp_err_t ret = sinricpro_find_payload(json_message, &payload_start, &payload_size);
+    if (ret != ESP_OK) {
+        return ret;
+    }
 
     if (payload_size >= payload_len) {
         ESP_LOGE(TAG, "Payload buffer too small (need %zu, have %zu)",
@@ -52,6 +52,22 @@ esp_err_t sinricpro_verify_signature(const char *secret,
                                       const char *payload,
                                       const char *received_signature);
 
+/**
+ * @brief Locate the payload object in a JSON message
+ *
+ * @param[in]  json_message  Complete JSON message string
+ * @param[out] payload_start First character of the payload object
+ * @param[out] payload_size  Length of the payload object, braces included
+ *
+ * @return
+ *     - ESP_OK: Success
+ *     - ESP_ERR_INVALID_ARG: Invalid arguments
+ *     - ESP_FAIL: Payload not found
+ */
+esp_err_t sinricpro_find_payload(const char *json_message,
+                                  const char **payload_start,
+                                  size_t *payload_size);
+
 /**
  * @brief Extract payload string from JSON message
  *
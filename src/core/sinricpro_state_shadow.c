@@ -0,0 +1,399 @@
+/*
+ * Copyright (c) 2019-2025 Sinric. All rights reserved.
+ * Licensed under Creative Commons Attribution-Share Alike (CC BY-SA)
+ *
+ * This file is part of the SinricPro ESP-IDF component
+ * (https://github.com/sinricpro/esp-idf)
+ */
+
+#include "sinricpro_state_shadow.h"
+#include "sinricpro_device_internal.h"
+#include <string.h>
+#include <math.h>
+#include "esp_log.h"
+#include "freertos/FreeRTOS.h"
+
+static const char *TAG = "sinricpro_state";
+
+#define STATE_DIGEST 0xFF   /* Slot type of objects, arrays and long strings */
+
+#define FNV_OFFSET 2166136261u
+#define FNV_PRIME  16777619u
+
+/**
+ * @brief Request that adjusts a shadowed number
+ */
+typedef struct {
+    const char *action;         /**< Request action */
+    const char *state_action;   /**< Action the result is reported under */
+    const char *property;       /**< Response property holding the result */
+    const char *delta;          /**< Request property holding the adjustment (NULL = step) */
+    double step;                /**< Fixed adjustment when delta is NULL */
+    double resolution;          /**< Precision of the reported value */
+    bool percent;               /**< Result is clamped to 0..100 */
+} state_adjust_t;
+
+static const state_adjust_t adjust_actions[] = {
+    { "adjustBrightness", "setBrightness", "brightness", "brightnessDelta", 0, 1, true },
+    { "adjustPowerLevel", "setPowerLevel", "powerLevel", "powerLevelDelta", 0, 1, true },
+    { "adjustVolume", "setVolume", "volume", "volume", 0, 1, true },
+    { "adjustRangeValue", "setRangeValue", "rangeValue", "rangeValueDelta", 0, 1, false },
+    { "adjustTargetTemperature", "targetTemperature", "temperature", "temperature", 0, 0.1, false },
+    { "increaseColorTemperature", "setColorTemperature", "colorTemperature", NULL, 500, 1, false },
+    { "decreaseColorTemperature", "setColorTemperature", "colorTemperature", NULL, -500, 1, false },
+};
+
+/* Actions that do not report device state */
+static const char *const stateless_actions[] = {
+    "pushNotification", "mediaControl", "powerUsage", "skipChannels", "setSetting",
+};
+
+static portMUX_TYPE state_lock = portMUX_INITIALIZER_UNLOCKED;
+
+static bool is_stateless(const char *action)
+{
+    for (size_t i = 0; i < sizeof(stateless_actions) / sizeof(stateless_actions[0]); i++) {
+        if (strcmp(action, stateless_actions[i]) == 0) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+static const state_adjust_t *find_adjust(const char *action)
+{
+    for (size_t i = 0; i < sizeof(adjust_actions) / sizeof(adjust_actions[0]); i++) {
+        if (strcmp(action, adjust_actions[i].action) == 0) {
+            return &adjust_actions[i];
+        }
+    }
+
+    return NULL;
+}
+
+static uint32_t fnv_string(uint32_t hash, const char *str)
+{
+    /* The terminator is hashed too, so "ab"+"c" differs from "a"+"bc" */
+    do {
+        hash ^= (uint8_t)*str;
+        hash *= FNV_PRIME;
+    } while (*str++ != '\0');
+
+    return hash;
+}
+
+static uint32_t fnv_bytes(uint32_t hash, const void *data, size_t length)
+{
+    const uint8_t *byte = data;
+
+    for (size_t i = 0; i < length; i++) {
+        hash ^= byte[i];
+        hash *= FNV_PRIME;
+    }
+
+    return hash;
+}
+
+static uint32_t action_hash(const char *action, const char *instance_id)
+{
+    uint32_t hash = fnv_string(FNV_OFFSET, action);
+
+    return fnv_string(hash, instance_id ? instance_id : "");
+}
+
+static uint16_t action_tag(uint32_t hash)
+{
+    return (uint16_t)(hash ^ (hash >> 16));
+}
+
+static uint32_t slot_key(const char *action, const char *instance_id, const char *property)
+{
+    uint32_t hash = fnv_string(action_hash(action, instance_id), property);
+
+    return hash != 0 ? hash : 1;
+}
+
+static uint32_t digest_item(uint32_t hash, const cJSON *item)
+{
+    hash = fnv_bytes(hash, &item->type, sizeof(item->type));
+
+    if (item->string) {
+        hash = fnv_string(hash, item->string);
+    }
+
+    if (cJSON_IsNumber(item)) {
+        hash = fnv_bytes(hash, &item->valuedouble, sizeof(item->valuedouble));
+    } else if (cJSON_IsString(item)) {
+        hash = fnv_string(hash, item->valuestring);
+    } else if (cJSON_IsArray(item) || cJSON_IsObject(item)) {
+        for (const cJSON *child = item->child; child; child = child->next) {
+            hash = digest_item(hash, child);
+        }
+    }
+
+    return hash;
+}
+
+/**
+ * @brief Convert a property into the form it is shadowed in
+ *
+ * @return false if the property cannot be shadowed
+ */
+static bool slot_from_item(const cJSON *item, sinricpro_state_slot_t *slot)
+{
+    memset(&slot->value, 0, sizeof(slot->value));
+
+    if (cJSON_IsNumber(item)) {
+        slot->type = SINRICPRO_STATE_NUMBER;
+        slot->value.number = item->valuedouble;
+    } else if (cJSON_IsBool(item)) {
+        slot->type = SINRICPRO_STATE_BOOL;
+        slot->value.boolean = cJSON_IsTrue(item);
+    } else if (cJSON_IsString(item) && strlen(item->valuestring) < SINRICPRO_STATE_STRING_LEN) {
+        slot->type = SINRICPRO_STATE_STRING;
+        strcpy(slot->value.string, item->valuestring);
+    } else if (cJSON_IsString(item) || cJSON_IsArray(item) || cJSON_IsObject(item)) {
+        slot->type = STATE_DIGEST;
+        slot->value.digest = digest_item(FNV_OFFSET, item);
+    } else {
+        return false;
+    }
+
+    return true;
+}
+
+/* Called with the lock held */
+static sinricpro_state_slot_t *find_slot(sinricpro_device_t *device, uint32_t key)
+{
+    for (int i = 0; i < CONFIG_SINRICPRO_STATE_SHADOW_SLOTS; i++) {
+        if (device->state[i].key == key) {
+            return &device->state[i];
+        }
+    }
+
+    return NULL;
+}
+
+static bool slot_equal(const sinricpro_state_slot_t *a, const sinricpro_state_slot_t *b)
+{
+    if (a->type != b->type) {
+        return false;
+    }
+
+    switch (a->type) {
+    case SINRICPRO_STATE_NUMBER:
+        return a->value.number == b->value.number;
+    case SINRICPRO_STATE_BOOL:
+        return a->value.boolean == b->value.boolean;
+    case SINRICPRO_STATE_STRING:
+        return strcmp(a->value.string, b->value.string) == 0;
+    default:
+        return a->value.digest == b->value.digest;
+    }
+}
+
+static void store_item(sinricpro_device_t *device,
+                       const char *action,
+                       const char *instance_id,
+                       const cJSON *item)
+{
+    sinricpro_state_slot_t update;
+
+    if (item->string == NULL || !slot_from_item(item, &update)) {
+        return;
+    }
+    update.key = slot_key(action, instance_id, item->string);
+    update.action = action_tag(action_hash(action, instance_id));
+
+    portENTER_CRITICAL(&state_lock);
+    sinricpro_state_slot_t *slot = find_slot(device, update.key);
+    if (slot == NULL) {
+        slot = find_slot(device, 0);
+    }
+    if (slot) {
+        *slot = update;
+    }
+    portEXIT_CRITICAL(&state_lock);
+
+    if (slot == NULL) {
+        ESP_LOGD(TAG, "No free slot for %s/%s on %s", action, item->string, device->device_id);
+    }
+}
+
+bool sinricpro_state_unchanged(sinricpro_device_t *device,
+                               const char *action,
+                               const char *instance_id,
+                               const cJSON *value)
+{
+    if (device == NULL || value == NULL || value->child == NULL || is_stateless(action)) {
+        return false;
+    }
+
+    for (const cJSON *item = value->child; item; item = item->next) {
+        sinricpro_state_slot_t reported;
+
+        if (item->string == NULL || !slot_from_item(item, &reported)) {
+            return false;
+        }
+
+        uint32_t key = slot_key(action, instance_id, item->string);
+
+        portENTER_CRITICAL(&state_lock);
+        const sinricpro_state_slot_t *slot = find_slot(device, key);
+        bool equal = slot != NULL && slot_equal(slot, &reported);
+        portEXIT_CRITICAL(&state_lock);
+
+        if (!equal) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void sinricpro_state_update(sinricpro_device_t *device,
+                            const char *action,
+                            const char *instance_id,
+                            const cJSON *value)
+{
+    if (device == NULL || value == NULL || is_stateless(action)) {
+        return;
+    }
+
+    for (const cJSON *item = value->child; item; item = item->next) {
+        store_item(device, action, instance_id, item);
+    }
+}
+
+void sinricpro_state_forget(sinricpro_device_t *device,
+                            const char *action,
+                            const char *instance_id)
+{
+    if (device == NULL || action == NULL) {
+        return;
+    }
+
+    /* A tag collision only forgets more than asked, which is harmless */
+    uint16_t tag = action_tag(action_hash(action, instance_id));
+
+    portENTER_CRITICAL(&state_lock);
+    for (int i = 0; i < CONFIG_SINRICPRO_STATE_SHADOW_SLOTS; i++) {
+        if (device->state[i].key != 0 && device->state[i].action == tag) {
+            memset(&device->state[i], 0, sizeof(sinricpro_state_slot_t));
+        }
+    }
+    portEXIT_CRITICAL(&state_lock);
+}
+
+static double round_to(double value, double resolution)
+{
+    return round(value / resolution) * resolution;
+}
+
+void sinricpro_state_apply_response(sinricpro_device_t *device,
+                                    const char *action,
+                                    const char *instance_id,
+                                    const cJSON *request_value,
+                                    cJSON *response_value)
+{
+    if (device == NULL || response_value == NULL || is_stateless(action)) {
+        return;
+    }
+
+    const state_adjust_t *adjust = find_adjust(action);
+    if (adjust == NULL) {
+        sinricpro_state_update(device, action, instance_id, response_value);
+        return;
+    }
+
+    cJSON *result = cJSON_GetObjectItem(response_value, adjust->property);
+    if (!cJSON_IsNumber(result)) {
+        return;
+    }
+
+    double delta = adjust->step;
+    if (adjust->delta) {
+        cJSON *delta_item = cJSON_GetObjectItem(request_value, adjust->delta);
+        if (!cJSON_IsNumber(delta_item)) {
+            return;
+        }
+        delta = delta_item->valuedouble;
+    }
+
+    /*
+     * A callback may write the resulting value over the adjustment. If it
+     * left the adjustment alone, the result is the shadowed value plus it.
+     */
+    if (fabs(result->valuedouble - delta) < adjust->resolution / 2) {
+        uint32_t key = slot_key(adjust->state_action, instance_id, adjust->property);
+        bool known = false;
+        double current = 0;
+
+        portENTER_CRITICAL(&state_lock);
+        const sinricpro_state_slot_t *slot = find_slot(device, key);
+        if (slot && slot->type == SINRICPRO_STATE_NUMBER) {
+            current = slot->value.number;
+            known = true;
+        }
+        portEXIT_CRITICAL(&state_lock);
+
+        if (!known) {
+            ESP_LOGD(TAG, "%s: no %s shadowed, responding with the adjustment",
+                     action, adjust->property);
+            return;
+        }
+
+        double absolute = round_to(current + delta, adjust->resolution);
+        if (adjust->percent) {
+            absolute = absolute < 0 ? 0 : (absolute > 100 ? 100 : absolute);
+        }
+        cJSON_SetNumberValue(result, absolute);
+    }
+
+    store_item(device, adjust->state_action, instance_id, result);
+}
+
+esp_err_t sinricpro_state_get(sinricpro_device_handle_t device,
+                              const char *action,
+                              const char *property,
+                              sinricpro_state_value_t *value)
+{
+    if (device == NULL || action == NULL || property == NULL || value == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    sinricpro_device_t *base = (sinricpro_device_t *)device;
+    uint32_t key = slot_key(action, NULL, property);
+    esp_err_t ret = ESP_OK;
+
+    portENTER_CRITICAL(&state_lock);
+    const sinricpro_state_slot_t *slot = find_slot(base, key);
+    if (slot == NULL) {
+        ret = ESP_ERR_NOT_FOUND;
+    } else if (slot->type == STATE_DIGEST) {
+        ret = ESP_ERR_NOT_SUPPORTED;
+    } else {
+        /* Both unions start with the same members */
+        value->type = (sinricpro_state_type_t)slot->type;
+        memcpy(value->string, slot->value.string, sizeof(value->string));
+    }
+    portEXIT_CRITICAL(&state_lock);
+
+    return ret;
+}
+
+esp_err_t sinricpro_state_clear(sinricpro_device_handle_t device)
+{
+    if (device == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    sinricpro_device_t *base = (sinricpro_device_t *)device;
+
+    portENTER_CRITICAL(&state_lock);
+    memset(base->state, 0, sizeof(base->state));
+    portEXIT_CRITICAL(&state_lock);
+
+    return ESP_OK;
+}
@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) 2019-2025 Sinric. All rights reserved.
+ * Licensed under Creative Commons Attribution-Share Alike (CC BY-SA)
+ *
+ * This file is part of the SinricPro ESP-IDF component
+ * (https://github.com/sinricpro/esp-idf)
+ */
+
+#ifndef SINRICPRO_STATE_SHADOW_H
+#define SINRICPRO_STATE_SHADOW_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "sdkconfig.h"
+#include "cJSON.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if CONFIG_SINRICPRO_STATE_SHADOW
+
+#include "sinricpro_state.h"
+
+struct sinricpro_device;
+
+/**
+ * @brief One shadowed property (internal)
+ *
+ * Objects, arrays and long strings keep only a digest, which is enough to
+ * tell whether an event changes them.
+ */
+typedef struct {
+    uint32_t key;       /**< Hash of action, instance and property (0 = free) */
+    uint16_t action;    /**< Hash of action and instance */
+    uint8_t type;       /**< sinricpro_state_type_t, or a digest */
+    union {
+        double number;
+        bool boolean;
+        char string[SINRICPRO_STATE_STRING_LEN];
+        uint32_t digest;
+    } value;
+} sinricpro_state_slot_t;
+
+/**
+ * @brief Check whether an event would report only what is already shadowed
+ *
+ * @param[in] device      Device
+ * @param[in] action      Event action
+ * @param[in] instance_id Instance ID (can be NULL)
+ * @param[in] value       Event value
+ *
+ * @return true if every property of value matches the shadow
+ */
+bool sinricpro_state_unchanged(struct sinricpro_device *device,
+                               const char *action,
+                               const char *instance_id,
+                               const cJSON *value);
+
+/**
+ * @brief Record the properties of a sent event
+ *
+ * @param[in] device      Device
+ * @param[in] action      Event action
+ * @param[in] instance_id Instance ID (can be NULL)
+ * @param[in] value       Event value
+ */
+void sinricpro_state_update(struct sinricpro_device *device,
+                            const char *action,
+                            const char *instance_id,
+                            const cJSON *value);
+
+/**
+ * @brief Resolve and record the result of a handled request
+ *
+ * Adjust requests whose callback left the adjustment unchanged are answered
+ * with the shadowed value plus the adjustment, rewriting response_value.
+ * The (absolute) result is then recorded under the matching set action.
+ *
+ * @param[in]     device        Device
+ * @param[in]     action        Request action
+ * @param[in]     instance_id   Instance ID (can be NULL)
+ * @param[in]     request_value Request value
+ * @param[in,out] response_value Response value
+ */
+void sinricpro_state_apply_response(struct sinricpro_device *device,
+                                    const char *action,
+                                    const char *instance_id,
+                                    const cJSON *request_value,
+                                    cJSON *response_value);
+
+/**
+ * @brief Forget the shadowed properties of one action
+ *
+ * @param[in] device      Device
+ * @param[in] action      Action
+ * @param[in] instance_id Instance ID (can be NULL)
+ */
+void sinricpro_state_forget(struct sinricpro_device *device,
+                            const char *action,
+                            const char *instance_id);
+
+#endif /* CONFIG_SINRICPRO_STATE_SHADOW */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SINRICPRO_STATE_SHADOW_H */
@@ -0,0 +1,235 @@
+/*
+ * Copyright (c) 2019-2025 Sinric. All rights reserved.
+ * Licensed under Creative Commons Attribution-Share Alike (CC BY-SA)
+ *
+ * This file is part of the SinricPro ESP-IDF component
+ * (https://github.com/sinricpro/esp-idf)
+ */
+
+#include "sinricpro_transport.h"
+#include "sinricpro_alloc.h"
+#include <stdlib.h>
+#include <string.h>
+#include "esp_log.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+
+static const char *TAG = "sinricpro_loopback";
+
+/**
+ * @brief Loopback transport state
+ *
+ * There is only one loopback "server", so a single instance is supported.
+ */
+static struct {
+    sinricpro_transport_callbacks_t callbacks;
+    sinricpro_loopback_sink_t sink;
+    void *sink_context;
+    char *app_key;
+    char *device_ids;
+    bool initialized;
+    bool connected;
+    SemaphoreHandle_t mutex;
+#if CONFIG_SINRICPRO_STATIC_ALLOCATION
+    StaticSemaphore_t mutex_buffer;
+#endif
+} loopback_state = {0};
+
+static SemaphoreHandle_t loopback_create_mutex(void)
+{
+#if CONFIG_SINRICPRO_STATIC_ALLOCATION
+    return xSemaphoreCreateMutexStatic(&loopback_state.mutex_buffer);
+#else
+    return xSemaphoreCreateMutex();
+#endif
+}
+
+static esp_err_t loopback_init(const sinricpro_transport_config_t *config,
+                                const sinricpro_transport_callbacks_t *callbacks,
+                                sinricpro_transport_handle_t *out_handle)
+{
+    if (config == NULL || callbacks == NULL || out_handle == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    if (loopback_state.initialized) {
+        ESP_LOGW(TAG, "Loopback already initialized");
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    if (loopback_state.mutex == NULL) {
+        /* Kept for the lifetime of the program so the sink can be set early */
+        loopback_state.mutex = loopback_create_mutex();
+        if (loopback_state.mutex == NULL) {
+            return ESP_ERR_NO_MEM;
+        }
+    }
+
+    loopback_state.app_key = sinricpro_strdup(config->app_key ? config->app_key : "");
+    loopback_state.device_ids = sinricpro_strdup(config->device_ids ? config->device_ids : "");
+    if (loopback_state.app_key == NULL || loopback_state.device_ids == NULL) {
+        sinricpro_free(loopback_state.app_key);
+        sinricpro_free(loopback_state.device_ids);
+        loopback_state.app_key = NULL;
+        loopback_state.device_ids = NULL;
+        return ESP_ERR_NO_MEM;
+    }
+
+    memcpy(&loopback_state.callbacks, callbacks, sizeof(sinricpro_transport_callbacks_t));
+    loopback_state.connected = false;
+    loopback_state.initialized = true;
+    *out_handle = &loopback_state;
+
+    ESP_LOGI(TAG, "Loopback initialized");
+
+    return ESP_OK;
+}
+
+static esp_err_t loopback_start(sinricpro_transport_handle_t handle)
+{
+    loopback_state.connected = true;
+
+    if (loopback_state.callbacks.on_connected) {
+        loopback_state.callbacks.on_connected(loopback_state.callbacks.context);
+    }
+
+    return ESP_OK;
+}
+
+static esp_err_t loopback_stop(sinricpro_transport_handle_t handle)
+{
+    if (!loopback_state.connected) {
+        return ESP_OK;
+    }
+
+    loopback_state.connected = false;
+
+    if (loopback_state.callbacks.on_disconnected) {
+        loopback_state.callbacks.on_disconnected(loopback_state.callbacks.context);
+    }
+
+    return ESP_OK;
+}
+
+static esp_err_t loopback_deinit(sinricpro_transport_handle_t handle)
+{
+    loopback_stop(handle);
+
+    sinricpro_free(loopback_state.app_key);
+    sinricpro_free(loopback_state.device_ids);
+    loopback_state.app_key = NULL;
+    loopback_state.device_ids = NULL;
+    loopback_state.initialized = false;
+
+    ESP_LOGI(TAG, "Loopback deinitialized");
+
+    return ESP_OK;
+}
+
+static bool loopback_is_connected(sinricpro_transport_handle_t handle)
+{
+    return loopback_state.connected;
+}
+
+static esp_err_t loopback_send(sinricpro_transport_handle_t handle,
+                                const char *message,
+                                size_t length)
+{
+    if (!loopback_state.connected) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    xSemaphoreTake(loopback_state.mutex, portMAX_DELAY);
+    sinricpro_loopback_sink_t sink = loopback_state.sink;
+    void *sink_context = loopback_state.sink_context;
+    xSemaphoreGive(loopback_state.mutex);
+
+    if (sink) {
+        /* The sink stands in for the network; its allocations are not ours */
+        SINRICPRO_ALLOC_OP_PAUSE();
+        sink(message, length, sink_context);
+        SINRICPRO_ALLOC_OP_RESUME();
+    }
+
+    return ESP_OK;
+}
+
+const sinricpro_transport_t sinricpro_transport_loopback = {
+    .name = "loopback",
+    .init = loopback_init,
+    .start = loopback_start,
+    .stop = loopback_stop,
+    .deinit = loopback_deinit,
+    .is_connected = loopback_is_connected,
+    .send = loopback_send,
+};
+
+esp_err_t sinricpro_loopback_set_sink(sinricpro_loopback_sink_t sink, void *context)
+{
+    if (loopback_state.mutex == NULL) {
+        loopback_state.mutex = loopback_create_mutex();
+        if (loopback_state.mutex == NULL) {
+            return ESP_ERR_NO_MEM;
+        }
+    }
+
+    xSemaphoreTake(loopback_state.mutex, portMAX_DELAY);
+    loopback_state.sink = sink;
+    loopback_state.sink_context = context;
+    xSemaphoreGive(loopback_state.mutex);
+
+    return ESP_OK;
+}
+
+esp_err_t sinricpro_loopback_inject(const char *data, size_t length)
+{
+    if (data == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    if (!loopback_state.connected) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    if (length == 0) {
+        length = strlen(data);
+    }
+
+    SINRICPRO_ALLOC_OP_BEGIN(SINRICPRO_ALLOC_OP_REQUEST);
+
+    /* Null-terminate the data, matching what the WebSocket transport delivers */
+    char *message = sinricpro_malloc(length + 1);
+    if (message == NULL) {
+        SINRICPRO_ALLOC_OP_END();
+        return ESP_ERR_NO_MEM;
+    }
+
+    memcpy(message, data, length);
+    message[length] = '\0';
+
+    if (loopback_state.callbacks.on_receive) {
+        loopback_state.callbacks.on_receive(message, length, loopback_state.callbacks.context);
+    }
+
+    sinricpro_free(message);
+
+    SINRICPRO_ALLOC_OP_END();
+
+    return ESP_OK;
+}
+
+esp_err_t sinricpro_loopback_get_handshake(const char **app_key, const char **device_ids)
+{
+    if (!loopback_state.initialized) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    if (app_key) {
+        *app_key = loopback_state.app_key;
+    }
+    if (device_ids) {
+        *device_ids = loopback_state.device_ids;
+    }
+
+    return ESP_OK;
+}
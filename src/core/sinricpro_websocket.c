@@ -7,7 +7,9 @@
  */
 
 #include "sinricpro_websocket.h"
+#include "sinricpro_alloc.h"
 #include "sinricpro.h"
+#include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
 #include "esp_log.h"
@@ -20,17 +22,28 @@
 
 static const char *TAG = "sinricpro_websocket";
 
+/* ========================================================================
+ * esp_websocket_client transport (wss:// and ws://)
+ * ======================================================================== */
+
 /**
- * @brief WebSocket client state
+ * @brief WebSocket client instance
  */
-static struct {
+typedef struct {
     esp_websocket_client_handle_t client;
-    sinricpro_ws_callbacks_t callbacks;
+    sinricpro_transport_callbacks_t callbacks;
     char *uri;
-    bool initialized;
+    char *rx_buffer;            /**< Reused receive buffer, grown on demand */
+    size_t rx_capacity;
     bool connected;
     SemaphoreHandle_t mutex;
-} ws_state = {0};
+#if CONFIG_SINRICPRO_STATIC_ALLOCATION
+    StaticSemaphore_t mutex_buffer;
+#endif
+} ws_client_t;
+
+/* Initial receive buffer; requests are usually a few hundred bytes */
+#define WS_RX_BUFFER_MIN 512
 
 /**
  * @brief WebSocket event handler
@@ -38,28 +51,29 @@ static struct {
 static void websocket_event_handler(void *arg, esp_event_base_t event_base,
                                      int32_t event_id, void *event_data)
 {
+    ws_client_t *ws = (ws_client_t *)arg;
     esp_websocket_event_data_t *data = (esp_websocket_event_data_t *)event_data;
 
     switch (event_id) {
     case WEBSOCKET_EVENT_CONNECTED:
         ESP_LOGI(TAG, "WebSocket connected");
-        xSemaphoreTake(ws_state.mutex, portMAX_DELAY);
-        ws_state.connected = true;
-        xSemaphoreGive(ws_state.mutex);
+        xSemaphoreTake(ws->mutex, portMAX_DELAY);
+        ws->connected = true;
+        xSemaphoreGive(ws->mutex);
 
-        if (ws_state.callbacks.on_connected) {
-            ws_state.callbacks.on_connected(ws_state.callbacks.context);
+        if (ws->callbacks.on_connected) {
+            ws->callbacks.on_connected(ws->callbacks.context);
         }
         break;
 
     case WEBSOCKET_EVENT_DISCONNECTED:
         ESP_LOGI(TAG, "WebSocket disconnected");
-        xSemaphoreTake(ws_state.mutex, portMAX_DELAY);
-        ws_state.connected = false;
-        xSemaphoreGive(ws_state.mutex);
+        xSemaphoreTake(ws->mutex, portMAX_DELAY);
+        ws->connected = false;
+        xSemaphoreGive(ws->mutex);
 
-        if (ws_state.callbacks.on_disconnected) {
-            ws_state.callbacks.on_disconnected(ws_state.callbacks.context);
+        if (ws->callbacks.on_disconnected) {
+            ws->callbacks.on_disconnected(ws->callbacks.context);
         }
         break;
 
@@ -67,21 +81,32 @@ static void websocket_event_handler(void *arg, esp_event_base_t event_base,
         ESP_LOGD(TAG, "WebSocket data received (len=%d)", data->data_len);
 
         if (data->data_len > 0 && data->data_ptr != NULL) {
-            /* Null-terminate the data */
-            char *message = malloc(data->data_len + 1);
-            if (message) {
-                memcpy(message, data->data_ptr, data->data_len);
-                message[data->data_len] = '\0';
-
-                if (ws_state.callbacks.on_receive) {
-                    ws_state.callbacks.on_receive(message, data->data_len,
-                                                   ws_state.callbacks.context);
+            SINRICPRO_ALLOC_OP_BEGIN(SINRICPRO_ALLOC_OP_REQUEST);
+
+            /* Null-terminate the data in the reused receive buffer */
+            size_t needed = (size_t)data->data_len + 1;
+            if (needed > ws->rx_capacity) {
+                size_t capacity = needed > WS_RX_BUFFER_MIN ? needed : WS_RX_BUFFER_MIN;
+                char *buffer = sinricpro_realloc(ws->rx_buffer, capacity);
+                if (buffer) {
+                    ws->rx_buffer = buffer;
+                    ws->rx_capacity = capacity;
                 }
+            }
+
+            if (needed <= ws->rx_capacity) {
+                memcpy(ws->rx_buffer, data->data_ptr, data->data_len);
+                ws->rx_buffer[data->data_len] = '\0';
 
-                free(message);
+                if (ws->callbacks.on_receive) {
+                    ws->callbacks.on_receive(ws->rx_buffer, data->data_len,
+                                             ws->callbacks.context);
+                }
             } else {
                 ESP_LOGE(TAG, "Failed to allocate memory for received message");
             }
+
+            SINRICPRO_ALLOC_OP_END();
         }
         break;
 
@@ -95,40 +120,64 @@ static void websocket_event_handler(void *arg, esp_event_base_t event_base,
     }
 }
 
-esp_err_t sinricpro_ws_init(const char *server_url,
-                             uint16_t server_port,
-                             const char *app_key,
-                             const char *device_ids,
-                             const sinricpro_ws_callbacks_t *callbacks)
+static void ws_client_free(ws_client_t *ws)
 {
-    if (server_url == NULL || app_key == NULL || device_ids == NULL || callbacks == NULL) {
+    if (ws->uri) {
+        sinricpro_free(ws->uri);
+    }
+    if (ws->rx_buffer) {
+        sinricpro_free(ws->rx_buffer);
+    }
+    if (ws->mutex) {
+        vSemaphoreDelete(ws->mutex);
+    }
+    sinricpro_free(ws);
+}
+
+static esp_err_t ws_client_init(const sinricpro_transport_config_t *config,
+                                 const sinricpro_transport_callbacks_t *callbacks,
+                                 bool secure,
+                                 sinricpro_transport_handle_t *out_handle)
+{
+    if (config == NULL || config->server_url == NULL || config->app_key == NULL ||
+        config->device_ids == NULL || callbacks == NULL || out_handle == NULL) {
         ESP_LOGE(TAG, "Invalid arguments");
         return ESP_ERR_INVALID_ARG;
     }
 
-    if (ws_state.initialized) {
-        ESP_LOGW(TAG, "WebSocket already initialized");
-        return ESP_ERR_INVALID_STATE;
+    ws_client_t *ws = sinricpro_calloc(1, sizeof(ws_client_t));
+    if (ws == NULL) {
+        ESP_LOGE(TAG, "Failed to allocate WebSocket client");
+        return ESP_ERR_NO_MEM;
     }
 
     /* Create mutex */
-    ws_state.mutex = xSemaphoreCreateMutex();
-    if (ws_state.mutex == NULL) {
+#if CONFIG_SINRICPRO_STATIC_ALLOCATION
+    ws->mutex = xSemaphoreCreateMutexStatic(&ws->mutex_buffer);
+#else
+    ws->mutex = xSemaphoreCreateMutex();
+#endif
+    if (ws->mutex == NULL) {
         ESP_LOGE(TAG, "Failed to create mutex");
+        ws_client_free(ws);
         return ESP_ERR_NO_MEM;
     }
 
     /* Build WebSocket URI (without query parameters) */
-    size_t uri_len = snprintf(NULL, 0, "wss://%s:%d/", server_url, server_port) + 1;
+    const char *scheme = secure ? "wss" : "ws";
+    const char *path = (config->path != NULL) ? config->path : "/";
+    size_t uri_len = snprintf(NULL, 0, "%s://%s:%d%s",
+                              scheme, config->server_url, config->server_port, path) + 1;
 
-    ws_state.uri = malloc(uri_len);
-    if (ws_state.uri == NULL) {
+    ws->uri = sinricpro_malloc(uri_len);
+    if (ws->uri == NULL) {
         ESP_LOGE(TAG, "Failed to allocate URI buffer");
-        vSemaphoreDelete(ws_state.mutex);
+        ws_client_free(ws);
         return ESP_ERR_NO_MEM;
     }
 
-    snprintf(ws_state.uri, uri_len, "wss://%s:%d/", server_url, server_port);
+    snprintf(ws->uri, uri_len, "%s://%s:%d%s",
+             scheme, config->server_url, config->server_port, path);
 
     /* Get IP address */
     esp_netif_t *netif = esp_netif_get_handle_from_ifkey("WIFI_STA_DEF");
@@ -155,75 +204,86 @@ esp_err_t sinricpro_ws_init(const char *server_url,
         "mac: %s\r\n"
         "platform: esp-idf\r\n"
         "SDKVersion: %s\r\n",
-        app_key, device_ids, ip_str, mac_str, SINRICPRO_VERSION);
+        config->app_key, config->device_ids, ip_str, mac_str, SINRICPRO_VERSION);
 
     if (headers_len < 0 || headers == NULL) {
         ESP_LOGE(TAG, "Failed to build headers");
-        free(ws_state.uri);
-        vSemaphoreDelete(ws_state.mutex);
+        ws_client_free(ws);
         return ESP_ERR_NO_MEM;
     }
 
     /* Save callbacks */
-    memcpy(&ws_state.callbacks, callbacks, sizeof(sinricpro_ws_callbacks_t));
+    memcpy(&ws->callbacks, callbacks, sizeof(sinricpro_transport_callbacks_t));
 
     /* Configure WebSocket client */
     esp_websocket_client_config_t ws_config = {
-        .uri = ws_state.uri,
+        .uri = ws->uri,
         .headers = headers,
         .buffer_size = 2048,
         .task_stack = CONFIG_SINRICPRO_WEBSOCKET_TASK_STACK_SIZE,
         .task_prio = CONFIG_SINRICPRO_WEBSOCKET_TASK_PRIORITY,
         .reconnect_timeout_ms = 10000,
         .network_timeout_ms = 10000,
-        .crt_bundle_attach = esp_crt_bundle_attach,  /* Use ESP-IDF cert bundle for TLS */
     };
 
+    if (secure) {
+        ws_config.crt_bundle_attach = esp_crt_bundle_attach;  /* Use ESP-IDF cert bundle for TLS */
+    }
+
     /* Initialize WebSocket client */
-    ws_state.client = esp_websocket_client_init(&ws_config);
+    ws->client = esp_websocket_client_init(&ws_config);
 
     /* Free headers after client init (client makes internal copy) */
     free(headers);
 
-    if (ws_state.client == NULL) {
+    if (ws->client == NULL) {
         ESP_LOGE(TAG, "Failed to initialize WebSocket client");
-        free(ws_state.uri);
-        vSemaphoreDelete(ws_state.mutex);
+        ws_client_free(ws);
         return ESP_FAIL;
     }
 
     /* Register event handler */
-    esp_err_t ret = esp_websocket_register_events(ws_state.client,
+    esp_err_t ret = esp_websocket_register_events(ws->client,
                                                     WEBSOCKET_EVENT_ANY,
                                                     websocket_event_handler,
-                                                    NULL);
+                                                    ws);
     if (ret != ESP_OK) {
         ESP_LOGE(TAG, "Failed to register WebSocket event handler: %s",
                  esp_err_to_name(ret));
-        esp_websocket_client_destroy(ws_state.client);
-        free(ws_state.uri);
-        vSemaphoreDelete(ws_state.mutex);
+        esp_websocket_client_destroy(ws->client);
+        ws_client_free(ws);
         return ret;
     }
 
-    ws_state.initialized = true;
-    ws_state.connected = false;
+    ws->connected = false;
+    *out_handle = ws;
 
-    ESP_LOGI(TAG, "WebSocket initialized");
+    ESP_LOGI(TAG, "WebSocket initialized (%s)", ws->uri);
 
     return ESP_OK;
 }
 
-esp_err_t sinricpro_ws_start(void)
+static esp_err_t ws_client_init_secure(const sinricpro_transport_config_t *config,
+                                        const sinricpro_transport_callbacks_t *callbacks,
+                                        sinricpro_transport_handle_t *out_handle)
 {
-    if (!ws_state.initialized) {
-        ESP_LOGE(TAG, "WebSocket not initialized");
-        return ESP_ERR_INVALID_STATE;
-    }
+    return ws_client_init(config, callbacks, true, out_handle);
+}
+
+static esp_err_t ws_client_init_plain(const sinricpro_transport_config_t *config,
+                                       const sinricpro_transport_callbacks_t *callbacks,
+                                       sinricpro_transport_handle_t *out_handle)
+{
+    return ws_client_init(config, callbacks, false, out_handle);
+}
+
+static esp_err_t ws_client_start(sinricpro_transport_handle_t handle)
+{
+    ws_client_t *ws = (ws_client_t *)handle;
 
     ESP_LOGI(TAG, "Starting WebSocket connection...");
 
-    esp_err_t ret = esp_websocket_client_start(ws_state.client);
+    esp_err_t ret = esp_websocket_client_start(ws->client);
     if (ret != ESP_OK) {
         ESP_LOGE(TAG, "Failed to start WebSocket client: %s", esp_err_to_name(ret));
         return ret;
@@ -232,79 +292,198 @@ esp_err_t sinricpro_ws_start(void)
     return ESP_OK;
 }
 
-esp_err_t sinricpro_ws_stop(void)
+static esp_err_t ws_client_stop(sinricpro_transport_handle_t handle)
 {
-    if (!ws_state.initialized) {
-        return ESP_OK;
-    }
+    ws_client_t *ws = (ws_client_t *)handle;
 
     ESP_LOGI(TAG, "Stopping WebSocket connection...");
 
-    esp_err_t ret = esp_websocket_client_stop(ws_state.client);
+    esp_err_t ret = esp_websocket_client_stop(ws->client);
     if (ret != ESP_OK) {
         ESP_LOGW(TAG, "WebSocket stop returned: %s", esp_err_to_name(ret));
     }
 
-    xSemaphoreTake(ws_state.mutex, portMAX_DELAY);
-    ws_state.connected = false;
-    xSemaphoreGive(ws_state.mutex);
+    xSemaphoreTake(ws->mutex, portMAX_DELAY);
+    ws->connected = false;
+    xSemaphoreGive(ws->mutex);
 
     return ESP_OK;
 }
 
-esp_err_t sinricpro_ws_deinit(void)
+static esp_err_t ws_client_deinit(sinricpro_transport_handle_t handle)
 {
-    if (!ws_state.initialized) {
-        return ESP_OK;
-    }
+    ws_client_t *ws = (ws_client_t *)handle;
 
     /* Stop first */
-    sinricpro_ws_stop();
+    ws_client_stop(ws);
 
     /* Destroy client */
-    if (ws_state.client) {
-        esp_websocket_client_destroy(ws_state.client);
-        ws_state.client = NULL;
+    if (ws->client) {
+        esp_websocket_client_destroy(ws->client);
+        ws->client = NULL;
     }
 
-    /* Free URI */
-    if (ws_state.uri) {
-        free(ws_state.uri);
-        ws_state.uri = NULL;
+    ws_client_free(ws);
+
+    ESP_LOGI(TAG, "WebSocket deinitialized");
+
+    return ESP_OK;
+}
+
+static bool ws_client_is_connected(sinricpro_transport_handle_t handle)
+{
+    ws_client_t *ws = (ws_client_t *)handle;
+
+    bool connected;
+    xSemaphoreTake(ws->mutex, portMAX_DELAY);
+    connected = ws->connected;
+    xSemaphoreGive(ws->mutex);
+
+    return connected;
+}
+
+static esp_err_t ws_client_send(sinricpro_transport_handle_t handle,
+                                 const char *message,
+                                 size_t length)
+{
+    ws_client_t *ws = (ws_client_t *)handle;
+
+    if (!ws_client_is_connected(ws)) {
+        ESP_LOGW(TAG, "WebSocket not connected, cannot send message");
+        return ESP_ERR_INVALID_STATE;
     }
 
-    /* Delete mutex */
-    if (ws_state.mutex) {
-        vSemaphoreDelete(ws_state.mutex);
-        ws_state.mutex = NULL;
+    ESP_LOGD(TAG, "Sending WebSocket message (len=%zu)", length);
+
+    int ret = esp_websocket_client_send_text(ws->client, message, length,
+                                               portMAX_DELAY);
+    if (ret < 0) {
+        ESP_LOGE(TAG, "Failed to send WebSocket message: %d", ret);
+        return ESP_FAIL;
     }
 
-    ws_state.initialized = false;
-    ws_state.connected = false;
+    ESP_LOGD(TAG, "WebSocket message sent successfully");
 
-    ESP_LOGI(TAG, "WebSocket deinitialized");
+    return ESP_OK;
+}
+
+const sinricpro_transport_t sinricpro_transport_websocket = {
+    .name = "wss",
+    .init = ws_client_init_secure,
+    .start = ws_client_start,
+    .stop = ws_client_stop,
+    .deinit = ws_client_deinit,
+    .is_connected = ws_client_is_connected,
+    .send = ws_client_send,
+};
+
+const sinricpro_transport_t sinricpro_transport_websocket_plain = {
+    .name = "ws",
+    .init = ws_client_init_plain,
+    .start = ws_client_start,
+    .stop = ws_client_stop,
+    .deinit = ws_client_deinit,
+    .is_connected = ws_client_is_connected,
+    .send = ws_client_send,
+};
+
+/* ========================================================================
+ * Transport dispatch
+ * ======================================================================== */
+
+/**
+ * @brief Active transport state
+ */
+static struct {
+    const sinricpro_transport_t *transport;
+    sinricpro_transport_handle_t handle;
+    bool initialized;
+} ws_state = {0};
+
+esp_err_t sinricpro_ws_init(const sinricpro_transport_t *transport,
+                             const sinricpro_transport_config_t *config,
+                             const sinricpro_transport_callbacks_t *callbacks)
+{
+    if (config == NULL || callbacks == NULL) {
+        ESP_LOGE(TAG, "Invalid arguments");
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    if (ws_state.initialized) {
+        ESP_LOGW(TAG, "Transport already initialized");
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    if (transport == NULL) {
+        transport = &sinricpro_transport_websocket;
+    }
+
+    if (transport->init == NULL || transport->start == NULL || transport->stop == NULL ||
+        transport->deinit == NULL || transport->is_connected == NULL || transport->send == NULL) {
+        ESP_LOGE(TAG, "Incomplete transport: %s", transport->name ? transport->name : "?");
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    esp_err_t ret = transport->init(config, callbacks, &ws_state.handle);
+    if (ret != ESP_OK) {
+        return ret;
+    }
+
+    ws_state.transport = transport;
+    ws_state.initialized = true;
+
+    ESP_LOGI(TAG, "Using %s transport", transport->name);
 
     return ESP_OK;
 }
 
+esp_err_t sinricpro_ws_start(void)
+{
+    if (!ws_state.initialized) {
+        ESP_LOGE(TAG, "Transport not initialized");
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    return ws_state.transport->start(ws_state.handle);
+}
+
+esp_err_t sinricpro_ws_stop(void)
+{
+    if (!ws_state.initialized) {
+        return ESP_OK;
+    }
+
+    return ws_state.transport->stop(ws_state.handle);
+}
+
+esp_err_t sinricpro_ws_deinit(void)
+{
+    if (!ws_state.initialized) {
+        return ESP_OK;
+    }
+
+    esp_err_t ret = ws_state.transport->deinit(ws_state.handle);
+
+    ws_state.transport = NULL;
+    ws_state.handle = NULL;
+    ws_state.initialized = false;
+
+    return ret;
+}
+
 bool sinricpro_ws_is_connected(void)
 {
     if (!ws_state.initialized) {
         return false;
     }
 
-    bool connected;
-    xSemaphoreTake(ws_state.mutex, portMAX_DELAY);
-    connected = ws_state.connected;
-    xSemaphoreGive(ws_state.mutex);
-
-    return connected;
+    return ws_state.transport->is_connected(ws_state.handle);
 }
 
 esp_err_t sinricpro_ws_send(const char *message, size_t length)
 {
     if (!ws_state.initialized) {
-        ESP_LOGE(TAG, "WebSocket not initialized");
+        ESP_LOGE(TAG, "Transport not initialized");
         return ESP_ERR_INVALID_STATE;
     }
 
@@ -313,25 +492,9 @@ esp_err_t sinricpro_ws_send(const char *message, size_t length)
         return ESP_ERR_INVALID_ARG;
     }
 
-    if (!sinricpro_ws_is_connected()) {
-        ESP_LOGW(TAG, "WebSocket not connected, cannot send message");
-        return ESP_ERR_INVALID_STATE;
-    }
-
     if (length == 0) {
         length = strlen(message);
     }
 
-    ESP_LOGD(TAG, "Sending WebSocket message (len=%zu)", length);
-
-    int ret = esp_websocket_client_send_text(ws_state.client, message, length,
-                                               portMAX_DELAY);
-    if (ret < 0) {
-        ESP_LOGE(TAG, "Failed to send WebSocket message: %d", ret);
-        return ESP_FAIL;
-    }
-
-    ESP_LOGD(TAG, "WebSocket message sent successfully");
-
-    return ESP_OK;
+    return ws_state.transport->send(ws_state.handle, message, length);
 }
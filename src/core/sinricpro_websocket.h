@@ -10,74 +10,39 @@
 #define SINRICPRO_WEBSOCKET_H
 
 #include "esp_err.h"
+#include "sinricpro_transport.h"
 #include <stdbool.h>
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
-/**
- * @brief WebSocket receive callback
- *
- * Called when a message is received from the server.
- *
- * @param[in] data    Message data
- * @param[in] length  Message length
- * @param[in] context User context
- */
-typedef void (*sinricpro_ws_receive_callback_t)(const char *data, size_t length, void *context);
-
-/**
- * @brief WebSocket connected callback
- *
- * Called when connected to the server.
- *
- * @param[in] context User context
- */
-typedef void (*sinricpro_ws_connected_callback_t)(void *context);
-
-/**
- * @brief WebSocket disconnected callback
- *
- * Called when disconnected from the server.
- *
- * @param[in] context User context
- */
-typedef void (*sinricpro_ws_disconnected_callback_t)(void *context);
-
-/**
- * @brief WebSocket callbacks structure
+/*
+ * The core talks to the server exclusively through the functions below.
+ * They forward to the sinricpro_transport_t selected at sinricpro_ws_init(),
+ * so the core does not depend on any particular transport.
  */
-typedef struct {
-    sinricpro_ws_receive_callback_t on_receive;
-    sinricpro_ws_connected_callback_t on_connected;
-    sinricpro_ws_disconnected_callback_t on_disconnected;
-    void *context;
-} sinricpro_ws_callbacks_t;
 
 /**
- * @brief Initialize WebSocket client
+ * @brief Initialize the transport layer
  *
- * @param[in] server_url   Server URL (e.g., "ws.sinric.pro")
- * @param[in] server_port  Server port (e.g., 80)
- * @param[in] app_key      APP_KEY for authentication
- * @param[in] device_ids   Semicolon-separated device IDs
- * @param[in] callbacks    Callback functions
+ * @param[in] transport  Transport implementation (NULL = sinricpro_transport_websocket)
+ * @param[in] config     Transport configuration
+ * @param[in] callbacks  Callback functions
  *
  * @return
  *     - ESP_OK: Success
  *     - ESP_ERR_INVALID_ARG: Invalid arguments
+ *     - ESP_ERR_INVALID_STATE: Already initialized
  *     - ESP_ERR_NO_MEM: Out of memory
- *     - ESP_FAIL: WebSocket initialization failed
+ *     - ESP_FAIL: Transport initialization failed
  */
-esp_err_t sinricpro_ws_init(const char *server_url,
-                             uint16_t server_port,
-                             const char *app_key,
-                             const char *device_ids,
-                             const sinricpro_ws_callbacks_t *callbacks);
+esp_err_t sinricpro_ws_init(const sinricpro_transport_t *transport,
+                             const sinricpro_transport_config_t *config,
+                             const sinricpro_transport_callbacks_t *callbacks);
 
 /**
- * @brief Start WebSocket connection
+ * @brief Start connection
  *
  * @return
  *     - ESP_OK: Success
@@ -87,28 +52,28 @@ esp_err_t sinricpro_ws_init(const char *server_url,
 esp_err_t sinricpro_ws_start(void);
 
 /**
- * @brief Stop WebSocket connection
+ * @brief Stop connection
  *
  * @return ESP_OK on success
  */
 esp_err_t sinricpro_ws_stop(void);
 
 /**
- * @brief Deinitialize WebSocket client
+ * @brief Deinitialize the transport layer
  *
  * @return ESP_OK on success
  */
 esp_err_t sinricpro_ws_deinit(void);
 
 /**
- * @brief Check if WebSocket is connected
+ * @brief Check if the transport is connected
  *
  * @return true if connected, false otherwise
  */
 bool sinricpro_ws_is_connected(void);
 
 /**
- * @brief Send a message via WebSocket
+ * @brief Send a message via the transport
  *
  * @param[in] message Message string to send
  * @param[in] length  Message length (0 = use strlen)
@@ -8,9 +8,14 @@
 
 #include "sinricpro_air_quality_sensor.h"
 #include "../core/sinricpro_device_internal.h"
+#include "../core/sinricpro_alloc.h"
 #include "../capabilities/air_quality_sensor.h"
+#if CONFIG_SINRICPRO_CAPABILITY_SETTING_CONTROLLER
 #include "../capabilities/setting_controller.h"
+#endif
+#if CONFIG_SINRICPRO_CAPABILITY_PUSH_NOTIFICATION
 #include "../capabilities/push_notification.h"
+#endif
 #include <stdlib.h>
 #include <string.h>
 #include "esp_log.h"
@@ -20,7 +25,9 @@ static const char *TAG = "sinricpro_airquality";
 typedef struct {
     sinricpro_device_t base;
     sinricpro_air_quality_sensor_handle_t air_quality_sensor;
+#if CONFIG_SINRICPRO_CAPABILITY_SETTING_CONTROLLER
     sinricpro_setting_controller_handle_t setting_controller;
+#endif
 } sinricpro_air_quality_sensor_device_t;
 
 static bool air_quality_sensor_request_handler(
@@ -31,6 +38,7 @@ static bool air_quality_sensor_request_handler(
     cJSON *response_value,
     void *user_data)
 {
+#if CONFIG_SINRICPRO_CAPABILITY_SETTING_CONTROLLER
     sinricpro_air_quality_sensor_device_t *dev = (sinricpro_air_quality_sensor_device_t *)user_data;
 
     if (sinricpro_setting_controller_handle_request(dev->setting_controller,
@@ -39,6 +47,7 @@ static bool air_quality_sensor_request_handler(
                                                       response_value)) {
         return true;
     }
+#endif
 
     ESP_LOGW(TAG, "Unhandled action: %s", action);
     return false;
@@ -51,7 +60,7 @@ sinricpro_device_handle_t sinricpro_air_quality_sensor_create(const char *device
         return NULL;
     }
 
-    sinricpro_air_quality_sensor_device_t *dev = malloc(sizeof(sinricpro_air_quality_sensor_device_t));
+    sinricpro_air_quality_sensor_device_t *dev = sinricpro_object_alloc(sizeof(sinricpro_air_quality_sensor_device_t));
     if (dev == NULL) {
         ESP_LOGE(TAG, "Failed to allocate AirQualitySensor device");
         return NULL;
@@ -65,9 +74,16 @@ sinricpro_device_handle_t sinricpro_air_quality_sensor_create(const char *device
     dev->base.user_data = dev;
 
     dev->air_quality_sensor = sinricpro_air_quality_sensor_capability_create();
+#if CONFIG_SINRICPRO_CAPABILITY_SETTING_CONTROLLER
     dev->setting_controller = sinricpro_setting_controller_create();
+#endif
 
-    if (dev->air_quality_sensor == NULL || dev->setting_controller == NULL) {
+    bool failed = dev->air_quality_sensor == NULL;
+#if CONFIG_SINRICPRO_CAPABILITY_SETTING_CONTROLLER
+    failed = failed || dev->setting_controller == NULL;
+#endif
+
+    if (failed) {
         ESP_LOGE(TAG, "Failed to create capabilities");
         sinricpro_air_quality_sensor_delete((sinricpro_device_handle_t)dev);
         return NULL;
@@ -95,9 +111,11 @@ esp_err_t sinricpro_air_quality_sensor_delete(sinricpro_device_handle_t device)
     sinricpro_core_unregister_device(dev->base.device_id);
 
     if (dev->air_quality_sensor) sinricpro_air_quality_sensor_destroy(dev->air_quality_sensor);
+#if CONFIG_SINRICPRO_CAPABILITY_SETTING_CONTROLLER
     if (dev->setting_controller) sinricpro_setting_controller_destroy(dev->setting_controller);
+#endif
 
-    free(dev);
+    sinricpro_object_free(dev);
     ESP_LOGI(TAG, "AirQualitySensor device deleted");
     return ESP_OK;
 }
@@ -119,3 +137,31 @@ esp_err_t sinricpro_air_quality_sensor_send_air_quality_event(
                                                      pm1, pm2_5, pm10,
                                                      cause);
 }
+
+esp_err_t sinricpro_air_quality_sensor_set_report_policy(
+    sinricpro_device_handle_t device,
+    const sinricpro_report_policy_t *policy)
+{
+    if (device == NULL || policy == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    sinricpro_air_quality_sensor_device_t *dev = (sinricpro_air_quality_sensor_device_t *)device;
+    return sinricpro_air_quality_sensor_capability_set_report_policy(dev->air_quality_sensor, policy);
+}
+
+esp_err_t sinricpro_air_quality_sensor_push_sample(
+    sinricpro_device_handle_t device,
+    int pm1,
+    int pm2_5,
+    int pm10)
+{
+    if (device == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    sinricpro_air_quality_sensor_device_t *dev = (sinricpro_air_quality_sensor_device_t *)device;
+    return sinricpro_air_quality_sensor_capability_push_sample(dev->air_quality_sensor,
+                                                                dev->base.device_id,
+                                                                pm1, pm2_5, pm10);
+}
@@ -8,10 +8,17 @@
 
 #include "sinricpro_blinds.h"
 #include "../core/sinricpro_device_internal.h"
+#include "../core/sinricpro_alloc.h"
+#if CONFIG_SINRICPRO_CAPABILITY_POWER_STATE_CONTROLLER
 #include "../capabilities/power_state_controller.h"
+#endif
 #include "../capabilities/range_controller.h"
+#if CONFIG_SINRICPRO_CAPABILITY_SETTING_CONTROLLER
 #include "../capabilities/setting_controller.h"
+#endif
+#if CONFIG_SINRICPRO_CAPABILITY_PUSH_NOTIFICATION
 #include "../capabilities/push_notification.h"
+#endif
 #include <stdlib.h>
 #include <string.h>
 #include "esp_log.h"
@@ -20,9 +27,13 @@ static const char *TAG = "blinds_device";
 
 typedef struct {
     sinricpro_device_t base;
+#if CONFIG_SINRICPRO_CAPABILITY_POWER_STATE_CONTROLLER
     sinricpro_power_state_controller_handle_t power_state_controller;
+#endif
     sinricpro_range_controller_handle_t range_controller;
+#if CONFIG_SINRICPRO_CAPABILITY_SETTING_CONTROLLER
     sinricpro_setting_controller_handle_t setting_controller;
+#endif
 } sinricpro_blinds_device_t;
 
 static bool blinds_request_handler(
@@ -35,6 +46,7 @@ static bool blinds_request_handler(
 {
     sinricpro_blinds_device_t *dev = (sinricpro_blinds_device_t *)user_data;
 
+#if CONFIG_SINRICPRO_CAPABILITY_POWER_STATE_CONTROLLER
     if (sinricpro_power_state_controller_handle_request(
             dev->power_state_controller,
             dev->base.device_id,
@@ -43,6 +55,7 @@ static bool blinds_request_handler(
             response_value)) {
         return true;
     }
+#endif
 
     if (sinricpro_range_controller_handle_request(
             dev->range_controller,
@@ -53,6 +66,7 @@ static bool blinds_request_handler(
         return true;
     }
 
+#if CONFIG_SINRICPRO_CAPABILITY_SETTING_CONTROLLER
     if (sinricpro_setting_controller_handle_request(
             dev->setting_controller,
             dev->base.device_id,
@@ -61,6 +75,7 @@ static bool blinds_request_handler(
             response_value)) {
         return true;
     }
+#endif
 
     ESP_LOGW(TAG, "Unhandled action: %s", action);
     return false;
@@ -73,7 +88,7 @@ sinricpro_device_handle_t sinricpro_blinds_create(const char *device_id)
         return NULL;
     }
 
-    sinricpro_blinds_device_t *dev = malloc(sizeof(sinricpro_blinds_device_t));
+    sinricpro_blinds_device_t *dev = sinricpro_object_alloc(sizeof(sinricpro_blinds_device_t));
     if (dev == NULL) {
         ESP_LOGE(TAG, "Failed to allocate blinds device");
         return NULL;
@@ -81,18 +96,32 @@ sinricpro_device_handle_t sinricpro_blinds_create(const char *device_id)
 
     memset(dev, 0, sizeof(sinricpro_blinds_device_t));
 
+#if CONFIG_SINRICPRO_CAPABILITY_POWER_STATE_CONTROLLER
     dev->power_state_controller = sinricpro_power_state_controller_create();
+#endif
     dev->range_controller = sinricpro_range_controller_create();
+#if CONFIG_SINRICPRO_CAPABILITY_SETTING_CONTROLLER
     dev->setting_controller = sinricpro_setting_controller_create();
+#endif
 
-    if (dev->power_state_controller == NULL ||
-        dev->range_controller == NULL ||
-        dev->setting_controller == NULL) {
+    bool failed = dev->range_controller == NULL;
+#if CONFIG_SINRICPRO_CAPABILITY_POWER_STATE_CONTROLLER
+    failed = failed || dev->power_state_controller == NULL;
+#endif
+#if CONFIG_SINRICPRO_CAPABILITY_SETTING_CONTROLLER
+    failed = failed || dev->setting_controller == NULL;
+#endif
+
+    if (failed) {
         ESP_LOGE(TAG, "Failed to create capabilities");
+#if CONFIG_SINRICPRO_CAPABILITY_POWER_STATE_CONTROLLER
         if (dev->power_state_controller) sinricpro_power_state_controller_destroy(dev->power_state_controller);
+#endif
         if (dev->range_controller) sinricpro_range_controller_destroy(dev->range_controller);
+#if CONFIG_SINRICPRO_CAPABILITY_SETTING_CONTROLLER
         if (dev->setting_controller) sinricpro_setting_controller_destroy(dev->setting_controller);
-        free(dev);
+#endif
+        sinricpro_object_free(dev);
         return NULL;
     }
 
@@ -105,10 +134,14 @@ sinricpro_device_handle_t sinricpro_blinds_create(const char *device_id)
     esp_err_t ret = sinricpro_core_register_device(&dev->base);
     if (ret != ESP_OK) {
         ESP_LOGE(TAG, "Failed to register blinds device");
+#if CONFIG_SINRICPRO_CAPABILITY_POWER_STATE_CONTROLLER
         sinricpro_power_state_controller_destroy(dev->power_state_controller);
+#endif
         sinricpro_range_controller_destroy(dev->range_controller);
+#if CONFIG_SINRICPRO_CAPABILITY_SETTING_CONTROLLER
         sinricpro_setting_controller_destroy(dev->setting_controller);
-        free(dev);
+#endif
+        sinricpro_object_free(dev);
         return NULL;
     }
 
@@ -116,6 +149,7 @@ sinricpro_device_handle_t sinricpro_blinds_create(const char *device_id)
     return (sinricpro_device_handle_t)dev;
 }
 
+#if CONFIG_SINRICPRO_CAPABILITY_POWER_STATE_CONTROLLER
 esp_err_t sinricpro_blinds_on_power_state(
     sinricpro_device_handle_t device,
     sinricpro_blinds_power_state_callback_t callback,
@@ -132,6 +166,7 @@ esp_err_t sinricpro_blinds_on_power_state(
         user_data
     );
 }
+#endif
 
 esp_err_t sinricpro_blinds_on_range_value(
     sinricpro_device_handle_t device,
@@ -167,6 +202,7 @@ esp_err_t sinricpro_blinds_on_adjust_range_value(
     );
 }
 
+#if CONFIG_SINRICPRO_CAPABILITY_POWER_STATE_CONTROLLER
 esp_err_t sinricpro_blinds_send_power_state_event(
     sinricpro_device_handle_t device,
     bool state,
@@ -184,6 +220,7 @@ esp_err_t sinricpro_blinds_send_power_state_event(
         cause
     );
 }
+#endif
 
 esp_err_t sinricpro_blinds_send_range_value_event(
     sinricpro_device_handle_t device,
@@ -8,9 +8,17 @@
 
 #include "sinricpro_contact_sensor.h"
 #include "../core/sinricpro_device_internal.h"
+#include "../core/sinricpro_alloc.h"
 #include "../capabilities/contact_sensor.h"
+#if CONFIG_SINRICPRO_CAPABILITY_SETTING_CONTROLLER
 #include "../capabilities/setting_controller.h"
+#endif
+#if CONFIG_SINRICPRO_CAPABILITY_PUSH_NOTIFICATION
 #include "../capabilities/push_notification.h"
+#endif
+#if CONFIG_SINRICPRO_INPUT
+#include "../core/sinricpro_input_dispatch.h"
+#endif
 #include <stdlib.h>
 #include <string.h>
 #include "esp_log.h"
@@ -20,7 +28,9 @@ static const char *TAG = "sinricpro_contact_sensor";
 typedef struct {
     sinricpro_device_t base;
     sinricpro_contact_sensor_handle_t contact_sensor;
+#if CONFIG_SINRICPRO_CAPABILITY_SETTING_CONTROLLER
     sinricpro_setting_controller_handle_t setting_controller;
+#endif
 } sinricpro_contact_sensor_device_t;
 
 static bool contact_sensor_request_handler(
@@ -31,6 +41,7 @@ static bool contact_sensor_request_handler(
     cJSON *response_value,
     void *user_data)
 {
+#if CONFIG_SINRICPRO_CAPABILITY_SETTING_CONTROLLER
     sinricpro_contact_sensor_device_t *dev = (sinricpro_contact_sensor_device_t *)user_data;
 
     if (sinricpro_setting_controller_handle_request(dev->setting_controller,
@@ -39,6 +50,7 @@ static bool contact_sensor_request_handler(
                                                       response_value)) {
         return true;
     }
+#endif
 
     ESP_LOGW(TAG, "Unhandled action: %s", action);
     return false;
@@ -51,7 +63,7 @@ sinricpro_device_handle_t sinricpro_contact_sensor_create(const char *device_id)
         return NULL;
     }
 
-    sinricpro_contact_sensor_device_t *dev = malloc(sizeof(sinricpro_contact_sensor_device_t));
+    sinricpro_contact_sensor_device_t *dev = sinricpro_object_alloc(sizeof(sinricpro_contact_sensor_device_t));
     if (dev == NULL) {
         ESP_LOGE(TAG, "Failed to allocate ContactSensor device");
         return NULL;
@@ -65,9 +77,16 @@ sinricpro_device_handle_t sinricpro_contact_sensor_create(const char *device_id)
     dev->base.user_data = dev;
 
     dev->contact_sensor = sinricpro_contact_sensor_capability_create();
+#if CONFIG_SINRICPRO_CAPABILITY_SETTING_CONTROLLER
     dev->setting_controller = sinricpro_setting_controller_create();
+#endif
 
-    if (dev->contact_sensor == NULL || dev->setting_controller == NULL) {
+    bool failed = dev->contact_sensor == NULL;
+#if CONFIG_SINRICPRO_CAPABILITY_SETTING_CONTROLLER
+    failed = failed || dev->setting_controller == NULL;
+#endif
+
+    if (failed) {
         ESP_LOGE(TAG, "Failed to create capabilities");
         sinricpro_contact_sensor_delete((sinricpro_device_handle_t)dev);
         return NULL;
@@ -92,12 +111,17 @@ esp_err_t sinricpro_contact_sensor_delete(sinricpro_device_handle_t device)
 
     sinricpro_contact_sensor_device_t *dev = (sinricpro_contact_sensor_device_t *)device;
 
+#if CONFIG_SINRICPRO_INPUT
+    sinricpro_input_unbind(device);
+#endif
     sinricpro_core_unregister_device(dev->base.device_id);
 
     if (dev->contact_sensor) sinricpro_contact_sensor_destroy(dev->contact_sensor);
+#if CONFIG_SINRICPRO_CAPABILITY_SETTING_CONTROLLER
     if (dev->setting_controller) sinricpro_setting_controller_destroy(dev->setting_controller);
+#endif
 
-    free(dev);
+    sinricpro_object_free(dev);
     ESP_LOGI(TAG, "ContactSensor device deleted");
     return ESP_OK;
 }
@@ -117,3 +141,22 @@ esp_err_t sinricpro_contact_sensor_send_contact_event(
                                                 detected,
                                                 cause);
 }
+
+#if CONFIG_SINRICPRO_INPUT
+static esp_err_t contact_sensor_input_handler(sinricpro_device_handle_t device, bool active)
+{
+    return sinricpro_contact_sensor_send_contact_event(device, active, SINRICPRO_CAUSE_PHYSICAL_INTERACTION);
+}
+
+esp_err_t sinricpro_contact_sensor_bind_gpio(
+    sinricpro_device_handle_t device,
+    const sinricpro_input_config_t *config)
+{
+    if (device == NULL || config == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    return sinricpro_input_bind(device, config, SINRICPRO_EVENT_LIMIT_STATE,
+                                contact_sensor_input_handler);
+}
+#endif
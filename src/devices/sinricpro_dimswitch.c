@@ -8,10 +8,15 @@
 
 #include "sinricpro_dimswitch.h"
 #include "../core/sinricpro_device_internal.h"
+#include "../core/sinricpro_alloc.h"
 #include "../capabilities/power_state_controller.h"
 #include "../capabilities/power_level_controller.h"
+#if CONFIG_SINRICPRO_CAPABILITY_SETTING_CONTROLLER
 #include "../capabilities/setting_controller.h"
+#endif
+#if CONFIG_SINRICPRO_CAPABILITY_PUSH_NOTIFICATION
 #include "../capabilities/push_notification.h"
+#endif
 #include <stdlib.h>
 #include <string.h>
 #include "esp_log.h"
@@ -22,7 +27,9 @@ typedef struct {
     sinricpro_device_t base;
     sinricpro_power_state_controller_handle_t power_state_controller;
     sinricpro_power_level_controller_handle_t power_level_controller;
+#if CONFIG_SINRICPRO_CAPABILITY_SETTING_CONTROLLER
     sinricpro_setting_controller_handle_t setting_controller;
+#endif
 } sinricpro_dimswitch_device_t;
 
 static bool dimswitch_request_handler(
@@ -49,6 +56,7 @@ static bool dimswitch_request_handler(
         return true;
     }
 
+#if CONFIG_SINRICPRO_CAPABILITY_SETTING_CONTROLLER
     /* Try setting controller */
     if (sinricpro_setting_controller_handle_request(dev->setting_controller,
                                                       device_id, action,
@@ -56,6 +64,7 @@ static bool dimswitch_request_handler(
                                                       response_value)) {
         return true;
     }
+#endif
 
     ESP_LOGW(TAG, "Unhandled action: %s", action);
     return false;
@@ -68,7 +77,7 @@ sinricpro_device_handle_t sinricpro_dimswitch_create(const char *device_id)
         return NULL;
     }
 
-    sinricpro_dimswitch_device_t *dev = malloc(sizeof(sinricpro_dimswitch_device_t));
+    sinricpro_dimswitch_device_t *dev = sinricpro_object_alloc(sizeof(sinricpro_dimswitch_device_t));
     if (dev == NULL) {
         ESP_LOGE(TAG, "Failed to allocate DimSwitch device");
         return NULL;
@@ -83,7 +92,9 @@ sinricpro_device_handle_t sinricpro_dimswitch_create(const char *device_id)
 
     dev->power_state_controller = sinricpro_power_state_controller_create();
     dev->power_level_controller = sinricpro_power_level_controller_create();
+#if CONFIG_SINRICPRO_CAPABILITY_SETTING_CONTROLLER
     dev->setting_controller = sinricpro_setting_controller_create();
+#endif
 
     if (dev->power_state_controller == NULL || dev->power_level_controller == NULL) {
         ESP_LOGE(TAG, "Failed to create capabilities");
@@ -114,9 +125,11 @@ esp_err_t sinricpro_dimswitch_delete(sinricpro_device_handle_t device)
 
     if (dev->power_state_controller) sinricpro_power_state_controller_destroy(dev->power_state_controller);
     if (dev->power_level_controller) sinricpro_power_level_controller_destroy(dev->power_level_controller);
+#if CONFIG_SINRICPRO_CAPABILITY_SETTING_CONTROLLER
     if (dev->setting_controller) sinricpro_setting_controller_destroy(dev->setting_controller);
+#endif
 
-    free(dev);
+    sinricpro_object_free(dev);
     ESP_LOGI(TAG, "DimSwitch device deleted");
     return ESP_OK;
 }
@@ -8,10 +8,17 @@
 
 #include "sinricpro_fan.h"
 #include "../core/sinricpro_device_internal.h"
+#include "../core/sinricpro_alloc.h"
 #include "../capabilities/power_state_controller.h"
+#if CONFIG_SINRICPRO_CAPABILITY_POWER_LEVEL_CONTROLLER
 #include "../capabilities/power_level_controller.h"
+#endif
+#if CONFIG_SINRICPRO_CAPABILITY_SETTING_CONTROLLER
 #include "../capabilities/setting_controller.h"
+#endif
+#if CONFIG_SINRICPRO_CAPABILITY_PUSH_NOTIFICATION
 #include "../capabilities/push_notification.h"
+#endif
 #include <stdlib.h>
 #include <string.h>
 #include "esp_log.h"
@@ -21,8 +28,12 @@ static const char *TAG = "sinricpro_fan";
 typedef struct {
     sinricpro_device_t base;
     sinricpro_power_state_controller_handle_t power_state_controller;
+#if CONFIG_SINRICPRO_CAPABILITY_POWER_LEVEL_CONTROLLER
     sinricpro_power_level_controller_handle_t power_level_controller;
+#endif
+#if CONFIG_SINRICPRO_CAPABILITY_SETTING_CONTROLLER
     sinricpro_setting_controller_handle_t setting_controller;
+#endif
 } sinricpro_fan_device_t;
 
 static bool fan_request_handler(
@@ -42,13 +53,16 @@ static bool fan_request_handler(
         return true;
     }
 
+#if CONFIG_SINRICPRO_CAPABILITY_POWER_LEVEL_CONTROLLER
     /* Try power level controller (fan speed) */
     if (sinricpro_power_level_controller_handle_request(dev->power_level_controller,
                                                           device_id, action,
                                                           request_value, response_value)) {
         return true;
     }
+#endif
 
+#if CONFIG_SINRICPRO_CAPABILITY_SETTING_CONTROLLER
     /* Try setting controller */
     if (sinricpro_setting_controller_handle_request(dev->setting_controller,
                                                       device_id, action,
@@ -56,6 +70,7 @@ static bool fan_request_handler(
                                                       response_value)) {
         return true;
     }
+#endif
 
     ESP_LOGW(TAG, "Unhandled action: %s", action);
     return false;
@@ -68,7 +83,7 @@ sinricpro_device_handle_t sinricpro_fan_create(const char *device_id)
         return NULL;
     }
 
-    sinricpro_fan_device_t *dev = malloc(sizeof(sinricpro_fan_device_t));
+    sinricpro_fan_device_t *dev = sinricpro_object_alloc(sizeof(sinricpro_fan_device_t));
     if (dev == NULL) {
         ESP_LOGE(TAG, "Failed to allocate Fan device");
         return NULL;
@@ -82,10 +97,19 @@ sinricpro_device_handle_t sinricpro_fan_create(const char *device_id)
     dev->base.user_data = dev;
 
     dev->power_state_controller = sinricpro_power_state_controller_create();
+#if CONFIG_SINRICPRO_CAPABILITY_POWER_LEVEL_CONTROLLER
     dev->power_level_controller = sinricpro_power_level_controller_create();
+#endif
+#if CONFIG_SINRICPRO_CAPABILITY_SETTING_CONTROLLER
     dev->setting_controller = sinricpro_setting_controller_create();
+#endif
 
-    if (dev->power_state_controller == NULL || dev->power_level_controller == NULL) {
+    bool failed = dev->power_state_controller == NULL;
+#if CONFIG_SINRICPRO_CAPABILITY_POWER_LEVEL_CONTROLLER
+    failed = failed || dev->power_level_controller == NULL;
+#endif
+
+    if (failed) {
         ESP_LOGE(TAG, "Failed to create capabilities");
         sinricpro_fan_delete((sinricpro_device_handle_t)dev);
         return NULL;
@@ -113,10 +137,14 @@ esp_err_t sinricpro_fan_delete(sinricpro_device_handle_t device)
     sinricpro_core_unregister_device(dev->base.device_id);
 
     if (dev->power_state_controller) sinricpro_power_state_controller_destroy(dev->power_state_controller);
+#if CONFIG_SINRICPRO_CAPABILITY_POWER_LEVEL_CONTROLLER
     if (dev->power_level_controller) sinricpro_power_level_controller_destroy(dev->power_level_controller);
+#endif
+#if CONFIG_SINRICPRO_CAPABILITY_SETTING_CONTROLLER
     if (dev->setting_controller) sinricpro_setting_controller_destroy(dev->setting_controller);
+#endif
 
-    free(dev);
+    sinricpro_object_free(dev);
     ESP_LOGI(TAG, "Fan device deleted");
     return ESP_OK;
 }
@@ -134,6 +162,7 @@ esp_err_t sinricpro_fan_on_power_state(
     return sinricpro_power_state_controller_set_callback(dev->power_state_controller, callback, user_data);
 }
 
+#if CONFIG_SINRICPRO_CAPABILITY_POWER_LEVEL_CONTROLLER
 esp_err_t sinricpro_fan_on_power_level(
     sinricpro_device_handle_t device,
     sinricpro_power_level_callback_t callback,
@@ -146,7 +175,9 @@ esp_err_t sinricpro_fan_on_power_level(
     sinricpro_fan_device_t *dev = (sinricpro_fan_device_t *)device;
     return sinricpro_power_level_controller_set_callback(dev->power_level_controller, callback, user_data);
 }
+#endif
 
+#if CONFIG_SINRICPRO_CAPABILITY_POWER_LEVEL_CONTROLLER
 esp_err_t sinricpro_fan_on_adjust_power_level(
     sinricpro_device_handle_t device,
     sinricpro_adjust_power_level_callback_t callback,
@@ -159,6 +190,7 @@ esp_err_t sinricpro_fan_on_adjust_power_level(
     sinricpro_fan_device_t *dev = (sinricpro_fan_device_t *)device;
     return sinricpro_power_level_controller_set_adjust_callback(dev->power_level_controller, callback, user_data);
 }
+#endif
 
 esp_err_t sinricpro_fan_send_power_state_event(
     sinricpro_device_handle_t device,
@@ -176,6 +208,7 @@ esp_err_t sinricpro_fan_send_power_state_event(
                                                          cause);
 }
 
+#if CONFIG_SINRICPRO_CAPABILITY_POWER_LEVEL_CONTROLLER
 esp_err_t sinricpro_fan_send_power_level_event(
     sinricpro_device_handle_t device,
     int level,
@@ -191,3 +224,4 @@ esp_err_t sinricpro_fan_send_power_level_event(
                                                          level,
                                                          cause);
 }
+#endif
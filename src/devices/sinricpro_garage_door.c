@@ -8,9 +8,14 @@
 
 #include "sinricpro_garage_door.h"
 #include "../core/sinricpro_device_internal.h"
+#include "../core/sinricpro_alloc.h"
 #include "../capabilities/door_controller.h"
+#if CONFIG_SINRICPRO_CAPABILITY_SETTING_CONTROLLER
 #include "../capabilities/setting_controller.h"
+#endif
+#if CONFIG_SINRICPRO_CAPABILITY_PUSH_NOTIFICATION
 #include "../capabilities/push_notification.h"
+#endif
 #include <stdlib.h>
 #include <string.h>
 #include "esp_log.h"
@@ -20,7 +25,9 @@ static const char *TAG = "sinricpro_garage_door";
 typedef struct {
     sinricpro_device_t base;
     sinricpro_door_controller_handle_t door_controller;
+#if CONFIG_SINRICPRO_CAPABILITY_SETTING_CONTROLLER
     sinricpro_setting_controller_handle_t setting_controller;
+#endif
 } sinricpro_garage_door_device_t;
 
 static bool garage_door_request_handler(
@@ -40,6 +47,7 @@ static bool garage_door_request_handler(
         return true;
     }
 
+#if CONFIG_SINRICPRO_CAPABILITY_SETTING_CONTROLLER
     /* Try setting controller */
     if (sinricpro_setting_controller_handle_request(dev->setting_controller,
                                                       device_id, action,
@@ -47,6 +55,7 @@ static bool garage_door_request_handler(
                                                       response_value)) {
         return true;
     }
+#endif
 
     ESP_LOGW(TAG, "Unhandled action: %s", action);
     return false;
@@ -59,7 +68,7 @@ sinricpro_device_handle_t sinricpro_garage_door_create(const char *device_id)
         return NULL;
     }
 
-    sinricpro_garage_door_device_t *dev = malloc(sizeof(sinricpro_garage_door_device_t));
+    sinricpro_garage_door_device_t *dev = sinricpro_object_alloc(sizeof(sinricpro_garage_door_device_t));
     if (dev == NULL) {
         ESP_LOGE(TAG, "Failed to allocate GarageDoor device");
         return NULL;
@@ -73,9 +82,16 @@ sinricpro_device_handle_t sinricpro_garage_door_create(const char *device_id)
     dev->base.user_data = dev;
 
     dev->door_controller = sinricpro_door_controller_create();
+#if CONFIG_SINRICPRO_CAPABILITY_SETTING_CONTROLLER
     dev->setting_controller = sinricpro_setting_controller_create();
+#endif
 
-    if (dev->door_controller == NULL || dev->setting_controller == NULL) {
+    bool failed = dev->door_controller == NULL;
+#if CONFIG_SINRICPRO_CAPABILITY_SETTING_CONTROLLER
+    failed = failed || dev->setting_controller == NULL;
+#endif
+
+    if (failed) {
         ESP_LOGE(TAG, "Failed to create capabilities");
         sinricpro_garage_door_delete((sinricpro_device_handle_t)dev);
         return NULL;
@@ -103,9 +119,11 @@ esp_err_t sinricpro_garage_door_delete(sinricpro_device_handle_t device)
     sinricpro_core_unregister_device(dev->base.device_id);
 
     if (dev->door_controller) sinricpro_door_controller_destroy(dev->door_controller);
+#if CONFIG_SINRICPRO_CAPABILITY_SETTING_CONTROLLER
     if (dev->setting_controller) sinricpro_setting_controller_destroy(dev->setting_controller);
+#endif
 
-    free(dev);
+    sinricpro_object_free(dev);
     ESP_LOGI(TAG, "GarageDoor device deleted");
     return ESP_OK;
 }
@@ -8,12 +8,23 @@
 
 #include "sinricpro_light.h"
 #include "../core/sinricpro_device_internal.h"
+#include "../core/sinricpro_alloc.h"
 #include "../capabilities/power_state_controller.h"
+#if CONFIG_SINRICPRO_CAPABILITY_BRIGHTNESS_CONTROLLER
 #include "../capabilities/brightness_controller.h"
+#endif
+#if CONFIG_SINRICPRO_CAPABILITY_COLOR_CONTROLLER
 #include "../capabilities/color_controller.h"
+#endif
+#if CONFIG_SINRICPRO_CAPABILITY_COLOR_TEMPERATURE_CONTROLLER
 #include "../capabilities/color_temperature_controller.h"
+#endif
+#if CONFIG_SINRICPRO_CAPABILITY_SETTING_CONTROLLER
 #include "../capabilities/setting_controller.h"
+#endif
+#if CONFIG_SINRICPRO_CAPABILITY_PUSH_NOTIFICATION
 #include "../capabilities/push_notification.h"
+#endif
 #include <stdlib.h>
 #include <string.h>
 #include "esp_log.h"
@@ -23,10 +34,18 @@ static const char *TAG = "light_device";
 typedef struct {
     sinricpro_device_t base;
     sinricpro_power_state_controller_handle_t power_state_controller;
+#if CONFIG_SINRICPRO_CAPABILITY_BRIGHTNESS_CONTROLLER
     sinricpro_brightness_controller_handle_t brightness_controller;
+#endif
+#if CONFIG_SINRICPRO_CAPABILITY_COLOR_CONTROLLER
     sinricpro_color_controller_handle_t color_controller;
+#endif
+#if CONFIG_SINRICPRO_CAPABILITY_COLOR_TEMPERATURE_CONTROLLER
     sinricpro_color_temperature_controller_handle_t color_temperature_controller;
+#endif
+#if CONFIG_SINRICPRO_CAPABILITY_SETTING_CONTROLLER
     sinricpro_setting_controller_handle_t setting_controller;
+#endif
 } sinricpro_light_device_t;
 
 static bool light_request_handler(
@@ -48,6 +67,7 @@ static bool light_request_handler(
         return true;
     }
 
+#if CONFIG_SINRICPRO_CAPABILITY_BRIGHTNESS_CONTROLLER
     if (sinricpro_brightness_controller_handle_request(
             dev->brightness_controller,
             dev->base.device_id,
@@ -56,7 +76,9 @@ static bool light_request_handler(
             response_value)) {
         return true;
     }
+#endif
 
+#if CONFIG_SINRICPRO_CAPABILITY_COLOR_CONTROLLER
     if (sinricpro_color_controller_handle_request(
             dev->color_controller,
             dev->base.device_id,
@@ -65,7 +87,9 @@ static bool light_request_handler(
             response_value)) {
         return true;
     }
+#endif
 
+#if CONFIG_SINRICPRO_CAPABILITY_COLOR_TEMPERATURE_CONTROLLER
     if (sinricpro_color_temperature_controller_handle_request(
             dev->color_temperature_controller,
             dev->base.device_id,
@@ -74,7 +98,9 @@ static bool light_request_handler(
             response_value)) {
         return true;
     }
+#endif
 
+#if CONFIG_SINRICPRO_CAPABILITY_SETTING_CONTROLLER
     if (sinricpro_setting_controller_handle_request(
             dev->setting_controller,
             dev->base.device_id,
@@ -83,6 +109,7 @@ static bool light_request_handler(
             response_value)) {
         return true;
     }
+#endif
 
     ESP_LOGW(TAG, "Unhandled action: %s", action);
     return false;
@@ -95,7 +122,7 @@ sinricpro_device_handle_t sinricpro_light_create(const char *device_id)
         return NULL;
     }
 
-    sinricpro_light_device_t *dev = malloc(sizeof(sinricpro_light_device_t));
+    sinricpro_light_device_t *dev = sinricpro_object_alloc(sizeof(sinricpro_light_device_t));
     if (dev == NULL) {
         ESP_LOGE(TAG, "Failed to allocate light device");
         return NULL;
@@ -104,23 +131,49 @@ sinricpro_device_handle_t sinricpro_light_create(const char *device_id)
     memset(dev, 0, sizeof(sinricpro_light_device_t));
 
     dev->power_state_controller = sinricpro_power_state_controller_create();
+#if CONFIG_SINRICPRO_CAPABILITY_BRIGHTNESS_CONTROLLER
     dev->brightness_controller = sinricpro_brightness_controller_create();
+#endif
+#if CONFIG_SINRICPRO_CAPABILITY_COLOR_CONTROLLER
     dev->color_controller = sinricpro_color_controller_create();
+#endif
+#if CONFIG_SINRICPRO_CAPABILITY_COLOR_TEMPERATURE_CONTROLLER
     dev->color_temperature_controller = sinricpro_color_temperature_controller_create();
+#endif
+#if CONFIG_SINRICPRO_CAPABILITY_SETTING_CONTROLLER
     dev->setting_controller = sinricpro_setting_controller_create();
-
-    if (dev->power_state_controller == NULL ||
-        dev->brightness_controller == NULL ||
-        dev->color_controller == NULL ||
-        dev->color_temperature_controller == NULL ||
-        dev->setting_controller == NULL) {
+#endif
+
+    bool failed = dev->power_state_controller == NULL;
+#if CONFIG_SINRICPRO_CAPABILITY_BRIGHTNESS_CONTROLLER
+    failed = failed || dev->brightness_controller == NULL;
+#endif
+#if CONFIG_SINRICPRO_CAPABILITY_COLOR_CONTROLLER
+    failed = failed || dev->color_controller == NULL;
+#endif
+#if CONFIG_SINRICPRO_CAPABILITY_COLOR_TEMPERATURE_CONTROLLER
+    failed = failed || dev->color_temperature_controller == NULL;
+#endif
+#if CONFIG_SINRICPRO_CAPABILITY_SETTING_CONTROLLER
+    failed = failed || dev->setting_controller == NULL;
+#endif
+
+    if (failed) {
         ESP_LOGE(TAG, "Failed to create capabilities");
         if (dev->power_state_controller) sinricpro_power_state_controller_destroy(dev->power_state_controller);
+#if CONFIG_SINRICPRO_CAPABILITY_BRIGHTNESS_CONTROLLER
         if (dev->brightness_controller) sinricpro_brightness_controller_destroy(dev->brightness_controller);
+#endif
+#if CONFIG_SINRICPRO_CAPABILITY_COLOR_CONTROLLER
         if (dev->color_controller) sinricpro_color_controller_destroy(dev->color_controller);
+#endif
+#if CONFIG_SINRICPRO_CAPABILITY_COLOR_TEMPERATURE_CONTROLLER
         if (dev->color_temperature_controller) sinricpro_color_temperature_controller_destroy(dev->color_temperature_controller);
+#endif
+#if CONFIG_SINRICPRO_CAPABILITY_SETTING_CONTROLLER
         if (dev->setting_controller) sinricpro_setting_controller_destroy(dev->setting_controller);
-        free(dev);
+#endif
+        sinricpro_object_free(dev);
         return NULL;
     }
 
@@ -134,11 +187,19 @@ sinricpro_device_handle_t sinricpro_light_create(const char *device_id)
     if (ret != ESP_OK) {
         ESP_LOGE(TAG, "Failed to register light device");
         sinricpro_power_state_controller_destroy(dev->power_state_controller);
+#if CONFIG_SINRICPRO_CAPABILITY_BRIGHTNESS_CONTROLLER
         sinricpro_brightness_controller_destroy(dev->brightness_controller);
+#endif
+#if CONFIG_SINRICPRO_CAPABILITY_COLOR_CONTROLLER
         sinricpro_color_controller_destroy(dev->color_controller);
+#endif
+#if CONFIG_SINRICPRO_CAPABILITY_COLOR_TEMPERATURE_CONTROLLER
         sinricpro_color_temperature_controller_destroy(dev->color_temperature_controller);
+#endif
+#if CONFIG_SINRICPRO_CAPABILITY_SETTING_CONTROLLER
         sinricpro_setting_controller_destroy(dev->setting_controller);
-        free(dev);
+#endif
+        sinricpro_object_free(dev);
         return NULL;
     }
 
@@ -163,6 +224,7 @@ esp_err_t sinricpro_light_on_power_state(
     );
 }
 
+#if CONFIG_SINRICPRO_CAPABILITY_BRIGHTNESS_CONTROLLER
 esp_err_t sinricpro_light_on_brightness(
     sinricpro_device_handle_t device,
     sinricpro_light_brightness_callback_t callback,
@@ -179,7 +241,9 @@ esp_err_t sinricpro_light_on_brightness(
         user_data
     );
 }
+#endif
 
+#if CONFIG_SINRICPRO_CAPABILITY_BRIGHTNESS_CONTROLLER
 esp_err_t sinricpro_light_on_adjust_brightness(
     sinricpro_device_handle_t device,
     sinricpro_light_adjust_brightness_callback_t callback,
@@ -196,7 +260,9 @@ esp_err_t sinricpro_light_on_adjust_brightness(
         user_data
     );
 }
+#endif
 
+#if CONFIG_SINRICPRO_CAPABILITY_COLOR_CONTROLLER
 esp_err_t sinricpro_light_on_color(
     sinricpro_device_handle_t device,
     sinricpro_light_color_callback_t callback,
@@ -213,7 +279,9 @@ esp_err_t sinricpro_light_on_color(
         user_data
     );
 }
+#endif
 
+#if CONFIG_SINRICPRO_CAPABILITY_COLOR_TEMPERATURE_CONTROLLER
 esp_err_t sinricpro_light_on_color_temperature(
     sinricpro_device_handle_t device,
     sinricpro_light_color_temperature_callback_t callback,
@@ -230,7 +298,9 @@ esp_err_t sinricpro_light_on_color_temperature(
         user_data
     );
 }
+#endif
 
+#if CONFIG_SINRICPRO_CAPABILITY_COLOR_TEMPERATURE_CONTROLLER
 esp_err_t sinricpro_light_on_adjust_color_temperature(
     sinricpro_device_handle_t device,
     sinricpro_light_adjust_color_temperature_callback_t callback,
@@ -247,6 +317,7 @@ esp_err_t sinricpro_light_on_adjust_color_temperature(
         user_data
     );
 }
+#endif
 
 esp_err_t sinricpro_light_send_power_state_event(
     sinricpro_device_handle_t device,
@@ -266,6 +337,7 @@ esp_err_t sinricpro_light_send_power_state_event(
     );
 }
 
+#if CONFIG_SINRICPRO_CAPABILITY_BRIGHTNESS_CONTROLLER
 esp_err_t sinricpro_light_send_brightness_event(
     sinricpro_device_handle_t device,
     int brightness,
@@ -283,7 +355,9 @@ esp_err_t sinricpro_light_send_brightness_event(
         cause
     );
 }
+#endif
 
+#if CONFIG_SINRICPRO_CAPABILITY_COLOR_CONTROLLER
 esp_err_t sinricpro_light_send_color_event(
     sinricpro_device_handle_t device,
     const sinricpro_light_color_t *color,
@@ -301,7 +375,9 @@ esp_err_t sinricpro_light_send_color_event(
         cause
     );
 }
+#endif
 
+#if CONFIG_SINRICPRO_CAPABILITY_COLOR_TEMPERATURE_CONTROLLER
 esp_err_t sinricpro_light_send_color_temperature_event(
     sinricpro_device_handle_t device,
     int color_temperature,
@@ -319,3 +395,4 @@ esp_err_t sinricpro_light_send_color_temperature_event(
         cause
     );
 }
+#endif
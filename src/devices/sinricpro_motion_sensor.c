@@ -8,9 +8,17 @@
 
 #include "sinricpro_motion_sensor.h"
 #include "../core/sinricpro_device_internal.h"
+#include "../core/sinricpro_alloc.h"
 #include "../capabilities/motion_sensor.h"
+#if CONFIG_SINRICPRO_CAPABILITY_SETTING_CONTROLLER
 #include "../capabilities/setting_controller.h"
+#endif
+#if CONFIG_SINRICPRO_CAPABILITY_PUSH_NOTIFICATION
 #include "../capabilities/push_notification.h"
+#endif
+#if CONFIG_SINRICPRO_INPUT
+#include "../core/sinricpro_input_dispatch.h"
+#endif
 #include <stdlib.h>
 #include <string.h>
 #include "esp_log.h"
@@ -23,7 +31,9 @@ static const char *TAG = "sinricpro_motion_sensor";
 typedef struct {
     sinricpro_device_t base;
     sinricpro_motion_sensor_handle_t motion_sensor;
+#if CONFIG_SINRICPRO_CAPABILITY_SETTING_CONTROLLER
     sinricpro_setting_controller_handle_t setting_controller;
+#endif
 } sinricpro_motion_sensor_device_t;
 
 /**
@@ -37,6 +47,7 @@ static bool motion_sensor_request_handler(
     cJSON *response_value,
     void *user_data)
 {
+#if CONFIG_SINRICPRO_CAPABILITY_SETTING_CONTROLLER
     sinricpro_motion_sensor_device_t *dev = (sinricpro_motion_sensor_device_t *)user_data;
 
     /* Try setting controller */
@@ -46,6 +57,7 @@ static bool motion_sensor_request_handler(
                                                       response_value)) {
         return true;
     }
+#endif
 
     /* MotionSensor has no controllable actions */
     ESP_LOGW(TAG, "Unhandled action: %s", action);
@@ -60,7 +72,7 @@ sinricpro_device_handle_t sinricpro_motion_sensor_create(const char *device_id)
     }
 
     /* Allocate device */
-    sinricpro_motion_sensor_device_t *dev = malloc(sizeof(sinricpro_motion_sensor_device_t));
+    sinricpro_motion_sensor_device_t *dev = sinricpro_object_alloc(sizeof(sinricpro_motion_sensor_device_t));
     if (dev == NULL) {
         ESP_LOGE(TAG, "Failed to allocate MotionSensor device");
         return NULL;
@@ -76,9 +88,16 @@ sinricpro_device_handle_t sinricpro_motion_sensor_create(const char *device_id)
 
     /* Create capabilities */
     dev->motion_sensor = sinricpro_motion_sensor_capability_create();
+#if CONFIG_SINRICPRO_CAPABILITY_SETTING_CONTROLLER
     dev->setting_controller = sinricpro_setting_controller_create();
+#endif
 
-    if (dev->motion_sensor == NULL || dev->setting_controller == NULL) {
+    bool failed = dev->motion_sensor == NULL;
+#if CONFIG_SINRICPRO_CAPABILITY_SETTING_CONTROLLER
+    failed = failed || dev->setting_controller == NULL;
+#endif
+
+    if (failed) {
         ESP_LOGE(TAG, "Failed to create capabilities");
         sinricpro_motion_sensor_delete((sinricpro_device_handle_t)dev);
         return NULL;
@@ -106,17 +125,22 @@ esp_err_t sinricpro_motion_sensor_delete(sinricpro_device_handle_t device)
     sinricpro_motion_sensor_device_t *dev = (sinricpro_motion_sensor_device_t *)device;
 
     /* Unregister device */
+#if CONFIG_SINRICPRO_INPUT
+    sinricpro_input_unbind(device);
+#endif
     sinricpro_core_unregister_device(dev->base.device_id);
 
     /* Destroy capabilities */
     if (dev->motion_sensor) {
         sinricpro_motion_sensor_destroy(dev->motion_sensor);
     }
+#if CONFIG_SINRICPRO_CAPABILITY_SETTING_CONTROLLER
     if (dev->setting_controller) {
         sinricpro_setting_controller_destroy(dev->setting_controller);
     }
+#endif
 
-    free(dev);
+    sinricpro_object_free(dev);
 
     ESP_LOGI(TAG, "MotionSensor device deleted");
 
@@ -139,3 +163,22 @@ esp_err_t sinricpro_motion_sensor_send_motion_event(
                                                detected,
                                                cause);
 }
+
+#if CONFIG_SINRICPRO_INPUT
+static esp_err_t motion_sensor_input_handler(sinricpro_device_handle_t device, bool active)
+{
+    return sinricpro_motion_sensor_send_motion_event(device, active, SINRICPRO_CAUSE_PHYSICAL_INTERACTION);
+}
+
+esp_err_t sinricpro_motion_sensor_bind_gpio(
+    sinricpro_device_handle_t device,
+    const sinricpro_input_config_t *config)
+{
+    if (device == NULL || config == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    return sinricpro_input_bind(device, config, SINRICPRO_EVENT_LIMIT_STATE,
+                                motion_sensor_input_handler);
+}
+#endif
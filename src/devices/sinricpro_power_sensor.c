@@ -8,9 +8,14 @@
 
 #include "sinricpro_power_sensor.h"
 #include "../core/sinricpro_device_internal.h"
+#include "../core/sinricpro_alloc.h"
 #include "../capabilities/power_sensor.h"
+#if CONFIG_SINRICPRO_CAPABILITY_SETTING_CONTROLLER
 #include "../capabilities/setting_controller.h"
+#endif
+#if CONFIG_SINRICPRO_CAPABILITY_PUSH_NOTIFICATION
 #include "../capabilities/push_notification.h"
+#endif
 #include <stdlib.h>
 #include <string.h>
 #include "esp_log.h"
@@ -20,7 +25,9 @@ static const char *TAG = "sinricpro_power_sensor";
 typedef struct {
     sinricpro_device_t base;
     sinricpro_power_sensor_handle_t power_sensor;
+#if CONFIG_SINRICPRO_CAPABILITY_SETTING_CONTROLLER
     sinricpro_setting_controller_handle_t setting_controller;
+#endif
 } sinricpro_power_sensor_device_t;
 
 static bool power_sensor_request_handler(
@@ -31,6 +38,7 @@ static bool power_sensor_request_handler(
     cJSON *response_value,
     void *user_data)
 {
+#if CONFIG_SINRICPRO_CAPABILITY_SETTING_CONTROLLER
     sinricpro_power_sensor_device_t *dev = (sinricpro_power_sensor_device_t *)user_data;
 
     if (sinricpro_setting_controller_handle_request(dev->setting_controller,
@@ -39,6 +47,7 @@ static bool power_sensor_request_handler(
                                                       response_value)) {
         return true;
     }
+#endif
 
     ESP_LOGW(TAG, "Unhandled action: %s", action);
     return false;
@@ -51,7 +60,7 @@ sinricpro_device_handle_t sinricpro_power_sensor_create(const char *device_id)
         return NULL;
     }
 
-    sinricpro_power_sensor_device_t *dev = malloc(sizeof(sinricpro_power_sensor_device_t));
+    sinricpro_power_sensor_device_t *dev = sinricpro_object_alloc(sizeof(sinricpro_power_sensor_device_t));
     if (dev == NULL) {
         ESP_LOGE(TAG, "Failed to allocate PowerSensor device");
         return NULL;
@@ -65,9 +74,16 @@ sinricpro_device_handle_t sinricpro_power_sensor_create(const char *device_id)
     dev->base.user_data = dev;
 
     dev->power_sensor = sinricpro_power_sensor_capability_create();
+#if CONFIG_SINRICPRO_CAPABILITY_SETTING_CONTROLLER
     dev->setting_controller = sinricpro_setting_controller_create();
+#endif
 
-    if (dev->power_sensor == NULL || dev->setting_controller == NULL) {
+    bool failed = dev->power_sensor == NULL;
+#if CONFIG_SINRICPRO_CAPABILITY_SETTING_CONTROLLER
+    failed = failed || dev->setting_controller == NULL;
+#endif
+
+    if (failed) {
         ESP_LOGE(TAG, "Failed to create capabilities");
         sinricpro_power_sensor_delete((sinricpro_device_handle_t)dev);
         return NULL;
@@ -95,9 +111,11 @@ esp_err_t sinricpro_power_sensor_delete(sinricpro_device_handle_t device)
     sinricpro_core_unregister_device(dev->base.device_id);
 
     if (dev->power_sensor) sinricpro_power_sensor_destroy(dev->power_sensor);
+#if CONFIG_SINRICPRO_CAPABILITY_SETTING_CONTROLLER
     if (dev->setting_controller) sinricpro_setting_controller_destroy(dev->setting_controller);
+#endif
 
-    free(dev);
+    sinricpro_object_free(dev);
     ESP_LOGI(TAG, "PowerSensor device deleted");
     return ESP_OK;
 }
@@ -123,3 +141,102 @@ esp_err_t sinricpro_power_sensor_send_power_sensor_event(
                                                apparent_power, reactive_power, factor,
                                                cause);
 }
+
+esp_err_t sinricpro_power_sensor_add_power_sample(
+    sinricpro_device_handle_t device,
+    float power)
+{
+    if (device == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    sinricpro_power_sensor_device_t *dev = (sinricpro_power_sensor_device_t *)device;
+    return sinricpro_power_sensor_capability_add_power_sample(dev->power_sensor,
+                                                               dev->base.device_id,
+                                                               power);
+}
+
+esp_err_t sinricpro_power_sensor_get_energy(
+    sinricpro_device_handle_t device,
+    double *total_wh,
+    double *interval_wh)
+{
+    if (device == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    sinricpro_power_sensor_device_t *dev = (sinricpro_power_sensor_device_t *)device;
+    return sinricpro_power_sensor_capability_get_energy(dev->power_sensor,
+                                                         dev->base.device_id,
+                                                         total_wh, interval_wh);
+}
+
+esp_err_t sinricpro_power_sensor_reset_energy(sinricpro_device_handle_t device)
+{
+    if (device == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    sinricpro_power_sensor_device_t *dev = (sinricpro_power_sensor_device_t *)device;
+    return sinricpro_power_sensor_capability_reset_energy(dev->power_sensor,
+                                                           dev->base.device_id);
+}
+
+esp_err_t sinricpro_power_sensor_set_report_policy(
+    sinricpro_device_handle_t device,
+    const sinricpro_report_policy_t *policy)
+{
+    if (device == NULL || policy == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    sinricpro_power_sensor_device_t *dev = (sinricpro_power_sensor_device_t *)device;
+    return sinricpro_power_sensor_capability_set_report_policy(dev->power_sensor, policy);
+}
+
+esp_err_t sinricpro_power_sensor_push_sample(
+    sinricpro_device_handle_t device,
+    float voltage,
+    float current,
+    float power,
+    float apparent_power,
+    float reactive_power,
+    float factor)
+{
+    if (device == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    sinricpro_power_sensor_device_t *dev = (sinricpro_power_sensor_device_t *)device;
+    return sinricpro_power_sensor_capability_push_sample(dev->power_sensor,
+                                                          dev->base.device_id,
+                                                          voltage, current, power,
+                                                          apparent_power, reactive_power, factor);
+}
+
+esp_err_t sinricpro_power_sensor_set_analysis(
+    sinricpro_device_handle_t device,
+    const sinricpro_power_analysis_config_t *config)
+{
+    if (device == NULL || config == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    sinricpro_power_sensor_device_t *dev = (sinricpro_power_sensor_device_t *)device;
+    return sinricpro_power_sensor_capability_set_analysis(dev->power_sensor, config);
+}
+
+esp_err_t sinricpro_power_sensor_process_samples(
+    sinricpro_device_handle_t device,
+    const uint16_t *samples,
+    size_t pairs)
+{
+    if (device == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    sinricpro_power_sensor_device_t *dev = (sinricpro_power_sensor_device_t *)device;
+    return sinricpro_power_sensor_capability_process_samples(dev->power_sensor,
+                                                              dev->base.device_id,
+                                                              samples, pairs);
+}
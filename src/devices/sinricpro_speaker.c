@@ -8,15 +8,32 @@
 
 #include "sinricpro_speaker.h"
 #include "../core/sinricpro_device_internal.h"
+#include "../core/sinricpro_alloc.h"
 #include "../capabilities/power_state_controller.h"
+#if CONFIG_SINRICPRO_CAPABILITY_VOLUME_CONTROLLER
 #include "../capabilities/volume_controller.h"
+#endif
+#if CONFIG_SINRICPRO_CAPABILITY_MUTE_CONTROLLER
 #include "../capabilities/mute_controller.h"
+#endif
+#if CONFIG_SINRICPRO_CAPABILITY_MEDIA_CONTROLLER
 #include "../capabilities/media_controller.h"
+#endif
+#if CONFIG_SINRICPRO_CAPABILITY_INPUT_CONTROLLER
 #include "../capabilities/input_controller.h"
+#endif
+#if CONFIG_SINRICPRO_CAPABILITY_EQUALIZER_CONTROLLER
 #include "../capabilities/equalizer_controller.h"
+#endif
+#if CONFIG_SINRICPRO_CAPABILITY_MODE_CONTROLLER
 #include "../capabilities/mode_controller.h"
+#endif
+#if CONFIG_SINRICPRO_CAPABILITY_SETTING_CONTROLLER
 #include "../capabilities/setting_controller.h"
+#endif
+#if CONFIG_SINRICPRO_CAPABILITY_PUSH_NOTIFICATION
 #include "../capabilities/push_notification.h"
+#endif
 #include <stdlib.h>
 #include <string.h>
 #include "esp_log.h"
@@ -26,13 +43,27 @@ static const char *TAG = "speaker_device";
 typedef struct {
     sinricpro_device_t base;
     sinricpro_power_state_controller_handle_t power_state_controller;
+#if CONFIG_SINRICPRO_CAPABILITY_VOLUME_CONTROLLER
     sinricpro_volume_controller_handle_t volume_controller;
+#endif
+#if CONFIG_SINRICPRO_CAPABILITY_MUTE_CONTROLLER
     sinricpro_mute_controller_handle_t mute_controller;
+#endif
+#if CONFIG_SINRICPRO_CAPABILITY_MEDIA_CONTROLLER
     sinricpro_media_controller_handle_t media_controller;
+#endif
+#if CONFIG_SINRICPRO_CAPABILITY_INPUT_CONTROLLER
     sinricpro_input_controller_handle_t input_controller;
+#endif
+#if CONFIG_SINRICPRO_CAPABILITY_EQUALIZER_CONTROLLER
     sinricpro_equalizer_controller_handle_t equalizer_controller;
+#endif
+#if CONFIG_SINRICPRO_CAPABILITY_MODE_CONTROLLER
     sinricpro_mode_controller_handle_t mode_controller;
+#endif
+#if CONFIG_SINRICPRO_CAPABILITY_SETTING_CONTROLLER
     sinricpro_setting_controller_handle_t setting_controller;
+#endif
 } sinricpro_speaker_device_t;
 
 static bool speaker_request_handler(
@@ -50,40 +81,54 @@ static bool speaker_request_handler(
         return true;
     }
 
+#if CONFIG_SINRICPRO_CAPABILITY_VOLUME_CONTROLLER
     if (sinricpro_volume_controller_handle_request(
             dev->volume_controller, dev->base.device_id, action, request_value, response_value)) {
         return true;
     }
+#endif
 
+#if CONFIG_SINRICPRO_CAPABILITY_MUTE_CONTROLLER
     if (sinricpro_mute_controller_handle_request(
             dev->mute_controller, dev->base.device_id, action, request_value, response_value)) {
         return true;
     }
+#endif
 
+#if CONFIG_SINRICPRO_CAPABILITY_MEDIA_CONTROLLER
     if (sinricpro_media_controller_handle_request(
             dev->media_controller, dev->base.device_id, action, request_value, response_value)) {
         return true;
     }
+#endif
 
+#if CONFIG_SINRICPRO_CAPABILITY_INPUT_CONTROLLER
     if (sinricpro_input_controller_handle_request(
             dev->input_controller, dev->base.device_id, action, request_value, response_value)) {
         return true;
     }
+#endif
 
+#if CONFIG_SINRICPRO_CAPABILITY_EQUALIZER_CONTROLLER
     if (sinricpro_equalizer_controller_handle_request(
             dev->equalizer_controller, dev->base.device_id, action, request_value, response_value)) {
         return true;
     }
+#endif
 
+#if CONFIG_SINRICPRO_CAPABILITY_MODE_CONTROLLER
     if (sinricpro_mode_controller_handle_request(
             dev->mode_controller, dev->base.device_id, action, request_value, response_value)) {
         return true;
     }
+#endif
 
+#if CONFIG_SINRICPRO_CAPABILITY_SETTING_CONTROLLER
     if (sinricpro_setting_controller_handle_request(
             dev->setting_controller, dev->base.device_id, action, request_value, response_value)) {
         return true;
     }
+#endif
 
     ESP_LOGW(TAG, "Unhandled action: %s", action);
     return false;
@@ -96,7 +141,7 @@ sinricpro_device_handle_t sinricpro_speaker_create(const char *device_id)
         return NULL;
     }
 
-    sinricpro_speaker_device_t *dev = malloc(sizeof(sinricpro_speaker_device_t));
+    sinricpro_speaker_device_t *dev = sinricpro_object_alloc(sizeof(sinricpro_speaker_device_t));
     if (dev == NULL) {
         ESP_LOGE(TAG, "Failed to allocate Speaker device");
         return NULL;
@@ -105,27 +150,76 @@ sinricpro_device_handle_t sinricpro_speaker_create(const char *device_id)
     memset(dev, 0, sizeof(sinricpro_speaker_device_t));
 
     dev->power_state_controller = sinricpro_power_state_controller_create();
+#if CONFIG_SINRICPRO_CAPABILITY_VOLUME_CONTROLLER
     dev->volume_controller = sinricpro_volume_controller_create();
+#endif
+#if CONFIG_SINRICPRO_CAPABILITY_MUTE_CONTROLLER
     dev->mute_controller = sinricpro_mute_controller_create();
+#endif
+#if CONFIG_SINRICPRO_CAPABILITY_MEDIA_CONTROLLER
     dev->media_controller = sinricpro_media_controller_create();
+#endif
+#if CONFIG_SINRICPRO_CAPABILITY_INPUT_CONTROLLER
     dev->input_controller = sinricpro_input_controller_create();
+#endif
+#if CONFIG_SINRICPRO_CAPABILITY_EQUALIZER_CONTROLLER
     dev->equalizer_controller = sinricpro_equalizer_controller_create();
+#endif
+#if CONFIG_SINRICPRO_CAPABILITY_MODE_CONTROLLER
     dev->mode_controller = sinricpro_mode_controller_create();
+#endif
+#if CONFIG_SINRICPRO_CAPABILITY_SETTING_CONTROLLER
     dev->setting_controller = sinricpro_setting_controller_create();
-
-    if (!dev->power_state_controller || !dev->volume_controller || !dev->mute_controller ||
-        !dev->media_controller || !dev->input_controller || !dev->equalizer_controller ||
-        !dev->mode_controller || !dev->setting_controller) {
+#endif
+
+    bool failed = !dev->power_state_controller;
+#if CONFIG_SINRICPRO_CAPABILITY_VOLUME_CONTROLLER
+    failed = failed || !dev->volume_controller;
+#endif
+#if CONFIG_SINRICPRO_CAPABILITY_MUTE_CONTROLLER
+    failed = failed || !dev->mute_controller;
+#endif
+#if CONFIG_SINRICPRO_CAPABILITY_MEDIA_CONTROLLER
+    failed = failed || !dev->media_controller;
+#endif
+#if CONFIG_SINRICPRO_CAPABILITY_INPUT_CONTROLLER
+    failed = failed || !dev->input_controller;
+#endif
+#if CONFIG_SINRICPRO_CAPABILITY_EQUALIZER_CONTROLLER
+    failed = failed || !dev->equalizer_controller;
+#endif
+#if CONFIG_SINRICPRO_CAPABILITY_MODE_CONTROLLER
+    failed = failed || !dev->mode_controller;
+#endif
+#if CONFIG_SINRICPRO_CAPABILITY_SETTING_CONTROLLER
+    failed = failed || !dev->setting_controller;
+#endif
+
+    if (failed) {
         ESP_LOGE(TAG, "Failed to create capabilities");
         if (dev->power_state_controller) sinricpro_power_state_controller_destroy(dev->power_state_controller);
+#if CONFIG_SINRICPRO_CAPABILITY_VOLUME_CONTROLLER
         if (dev->volume_controller) sinricpro_volume_controller_destroy(dev->volume_controller);
+#endif
+#if CONFIG_SINRICPRO_CAPABILITY_MUTE_CONTROLLER
         if (dev->mute_controller) sinricpro_mute_controller_destroy(dev->mute_controller);
+#endif
+#if CONFIG_SINRICPRO_CAPABILITY_MEDIA_CONTROLLER
         if (dev->media_controller) sinricpro_media_controller_destroy(dev->media_controller);
+#endif
+#if CONFIG_SINRICPRO_CAPABILITY_INPUT_CONTROLLER
         if (dev->input_controller) sinricpro_input_controller_destroy(dev->input_controller);
+#endif
+#if CONFIG_SINRICPRO_CAPABILITY_EQUALIZER_CONTROLLER
         if (dev->equalizer_controller) sinricpro_equalizer_controller_destroy(dev->equalizer_controller);
+#endif
+#if CONFIG_SINRICPRO_CAPABILITY_MODE_CONTROLLER
         if (dev->mode_controller) sinricpro_mode_controller_destroy(dev->mode_controller);
+#endif
+#if CONFIG_SINRICPRO_CAPABILITY_SETTING_CONTROLLER
         if (dev->setting_controller) sinricpro_setting_controller_destroy(dev->setting_controller);
-        free(dev);
+#endif
+        sinricpro_object_free(dev);
         return NULL;
     }
 
@@ -139,14 +233,28 @@ sinricpro_device_handle_t sinricpro_speaker_create(const char *device_id)
     if (ret != ESP_OK) {
         ESP_LOGE(TAG, "Failed to register Speaker device");
         sinricpro_power_state_controller_destroy(dev->power_state_controller);
+#if CONFIG_SINRICPRO_CAPABILITY_VOLUME_CONTROLLER
         sinricpro_volume_controller_destroy(dev->volume_controller);
+#endif
+#if CONFIG_SINRICPRO_CAPABILITY_MUTE_CONTROLLER
         sinricpro_mute_controller_destroy(dev->mute_controller);
+#endif
+#if CONFIG_SINRICPRO_CAPABILITY_MEDIA_CONTROLLER
         sinricpro_media_controller_destroy(dev->media_controller);
+#endif
+#if CONFIG_SINRICPRO_CAPABILITY_INPUT_CONTROLLER
         sinricpro_input_controller_destroy(dev->input_controller);
+#endif
+#if CONFIG_SINRICPRO_CAPABILITY_EQUALIZER_CONTROLLER
         sinricpro_equalizer_controller_destroy(dev->equalizer_controller);
+#endif
+#if CONFIG_SINRICPRO_CAPABILITY_MODE_CONTROLLER
         sinricpro_mode_controller_destroy(dev->mode_controller);
+#endif
+#if CONFIG_SINRICPRO_CAPABILITY_SETTING_CONTROLLER
         sinricpro_setting_controller_destroy(dev->setting_controller);
-        free(dev);
+#endif
+        sinricpro_object_free(dev);
         return NULL;
     }
 
@@ -160,47 +268,61 @@ esp_err_t sinricpro_speaker_on_power_state(sinricpro_device_handle_t device, sin
     return sinricpro_power_state_controller_set_callback(dev->power_state_controller, callback, user_data);
 }
 
+#if CONFIG_SINRICPRO_CAPABILITY_VOLUME_CONTROLLER
 esp_err_t sinricpro_speaker_on_volume(sinricpro_device_handle_t device, sinricpro_speaker_volume_callback_t callback, void *user_data) {
     if (device == NULL || callback == NULL) return ESP_ERR_INVALID_ARG;
     sinricpro_speaker_device_t *dev = (sinricpro_speaker_device_t *)device;
     return sinricpro_volume_controller_set_callback(dev->volume_controller, callback, user_data);
 }
+#endif
 
+#if CONFIG_SINRICPRO_CAPABILITY_VOLUME_CONTROLLER
 esp_err_t sinricpro_speaker_on_adjust_volume(sinricpro_device_handle_t device, sinricpro_speaker_adjust_volume_callback_t callback, void *user_data) {
     if (device == NULL || callback == NULL) return ESP_ERR_INVALID_ARG;
     sinricpro_speaker_device_t *dev = (sinricpro_speaker_device_t *)device;
     return sinricpro_volume_controller_set_adjust_callback(dev->volume_controller, callback, user_data);
 }
+#endif
 
+#if CONFIG_SINRICPRO_CAPABILITY_MUTE_CONTROLLER
 esp_err_t sinricpro_speaker_on_mute(sinricpro_device_handle_t device, sinricpro_speaker_mute_callback_t callback, void *user_data) {
     if (device == NULL || callback == NULL) return ESP_ERR_INVALID_ARG;
     sinricpro_speaker_device_t *dev = (sinricpro_speaker_device_t *)device;
     return sinricpro_mute_controller_set_callback(dev->mute_controller, callback, user_data);
 }
+#endif
 
+#if CONFIG_SINRICPRO_CAPABILITY_MEDIA_CONTROLLER
 esp_err_t sinricpro_speaker_on_media_control(sinricpro_device_handle_t device, sinricpro_speaker_media_control_callback_t callback, void *user_data) {
     if (device == NULL || callback == NULL) return ESP_ERR_INVALID_ARG;
     sinricpro_speaker_device_t *dev = (sinricpro_speaker_device_t *)device;
     return sinricpro_media_controller_set_callback(dev->media_controller, callback, user_data);
 }
+#endif
 
+#if CONFIG_SINRICPRO_CAPABILITY_INPUT_CONTROLLER
 esp_err_t sinricpro_speaker_on_input(sinricpro_device_handle_t device, sinricpro_speaker_input_callback_t callback, void *user_data) {
     if (device == NULL || callback == NULL) return ESP_ERR_INVALID_ARG;
     sinricpro_speaker_device_t *dev = (sinricpro_speaker_device_t *)device;
     return sinricpro_input_controller_set_callback(dev->input_controller, callback, user_data);
 }
+#endif
 
+#if CONFIG_SINRICPRO_CAPABILITY_EQUALIZER_CONTROLLER
 esp_err_t sinricpro_speaker_on_equalizer(sinricpro_device_handle_t device, sinricpro_speaker_equalizer_callback_t callback, void *user_data) {
     if (device == NULL || callback == NULL) return ESP_ERR_INVALID_ARG;
     sinricpro_speaker_device_t *dev = (sinricpro_speaker_device_t *)device;
     return sinricpro_equalizer_controller_set_callback(dev->equalizer_controller, (sinricpro_equalizer_callback_t)callback, user_data);
 }
+#endif
 
+#if CONFIG_SINRICPRO_CAPABILITY_MODE_CONTROLLER
 esp_err_t sinricpro_speaker_on_mode(sinricpro_device_handle_t device, sinricpro_speaker_mode_callback_t callback, void *user_data) {
     if (device == NULL || callback == NULL) return ESP_ERR_INVALID_ARG;
     sinricpro_speaker_device_t *dev = (sinricpro_speaker_device_t *)device;
     return sinricpro_mode_controller_set_callback(dev->mode_controller, callback, user_data);
 }
+#endif
 
 esp_err_t sinricpro_speaker_send_power_state_event(sinricpro_device_handle_t device, bool state, const char *cause) {
     if (device == NULL || cause == NULL) return ESP_ERR_INVALID_ARG;
@@ -208,38 +330,50 @@ esp_err_t sinricpro_speaker_send_power_state_event(sinricpro_device_handle_t dev
     return sinricpro_power_state_controller_send_event(dev->power_state_controller, dev->base.device_id, state, cause);
 }
 
+#if CONFIG_SINRICPRO_CAPABILITY_VOLUME_CONTROLLER
 esp_err_t sinricpro_speaker_send_volume_event(sinricpro_device_handle_t device, int volume, const char *cause) {
     if (device == NULL || cause == NULL) return ESP_ERR_INVALID_ARG;
     sinricpro_speaker_device_t *dev = (sinricpro_speaker_device_t *)device;
     return sinricpro_volume_controller_send_event(dev->volume_controller, dev->base.device_id, volume, cause);
 }
+#endif
 
+#if CONFIG_SINRICPRO_CAPABILITY_MUTE_CONTROLLER
 esp_err_t sinricpro_speaker_send_mute_event(sinricpro_device_handle_t device, bool mute, const char *cause) {
     if (device == NULL || cause == NULL) return ESP_ERR_INVALID_ARG;
     sinricpro_speaker_device_t *dev = (sinricpro_speaker_device_t *)device;
     return sinricpro_mute_controller_send_event(dev->mute_controller, dev->base.device_id, mute, cause);
 }
+#endif
 
+#if CONFIG_SINRICPRO_CAPABILITY_MEDIA_CONTROLLER
 esp_err_t sinricpro_speaker_send_media_control_event(sinricpro_device_handle_t device, const char *control, const char *cause) {
     if (device == NULL || control == NULL || cause == NULL) return ESP_ERR_INVALID_ARG;
     sinricpro_speaker_device_t *dev = (sinricpro_speaker_device_t *)device;
     return sinricpro_media_controller_send_event(dev->media_controller, dev->base.device_id, control, cause);
 }
+#endif
 
+#if CONFIG_SINRICPRO_CAPABILITY_INPUT_CONTROLLER
 esp_err_t sinricpro_speaker_send_input_event(sinricpro_device_handle_t device, const char *input, const char *cause) {
     if (device == NULL || input == NULL || cause == NULL) return ESP_ERR_INVALID_ARG;
     sinricpro_speaker_device_t *dev = (sinricpro_speaker_device_t *)device;
     return sinricpro_input_controller_send_event(dev->input_controller, dev->base.device_id, input, cause);
 }
+#endif
 
+#if CONFIG_SINRICPRO_CAPABILITY_EQUALIZER_CONTROLLER
 esp_err_t sinricpro_speaker_send_equalizer_event(sinricpro_device_handle_t device, const sinricpro_speaker_equalizer_bands_t *bands, const char *cause) {
     if (device == NULL || bands == NULL || cause == NULL) return ESP_ERR_INVALID_ARG;
     sinricpro_speaker_device_t *dev = (sinricpro_speaker_device_t *)device;
     return sinricpro_equalizer_controller_send_event(dev->equalizer_controller, dev->base.device_id, (const sinricpro_equalizer_bands_t *)bands, cause);
 }
+#endif
 
+#if CONFIG_SINRICPRO_CAPABILITY_MODE_CONTROLLER
 esp_err_t sinricpro_speaker_send_mode_event(sinricpro_device_handle_t device, const char *mode, const char *cause) {
     if (device == NULL || mode == NULL || cause == NULL) return ESP_ERR_INVALID_ARG;
     sinricpro_speaker_device_t *dev = (sinricpro_speaker_device_t *)device;
     return sinricpro_mode_controller_send_event(dev->mode_controller, dev->base.device_id, mode, cause);
 }
+#endif
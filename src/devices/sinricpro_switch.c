@@ -8,9 +8,14 @@
 
 #include "sinricpro_switch.h"
 #include "../core/sinricpro_device_internal.h"
+#include "../core/sinricpro_alloc.h"
 #include "../capabilities/power_state_controller.h"
+#if CONFIG_SINRICPRO_CAPABILITY_SETTING_CONTROLLER
 #include "../capabilities/setting_controller.h"
+#endif
+#if CONFIG_SINRICPRO_CAPABILITY_PUSH_NOTIFICATION
 #include "../capabilities/push_notification.h"
+#endif
 #include <stdlib.h>
 #include <string.h>
 #include "esp_log.h"
@@ -23,7 +28,9 @@ static const char *TAG = "sinricpro_switch";
 typedef struct {
     sinricpro_device_t base;  /* Base device structure */
     sinricpro_power_state_controller_handle_t power_state;
+#if CONFIG_SINRICPRO_CAPABILITY_SETTING_CONTROLLER
     sinricpro_setting_controller_handle_t setting;
+#endif
 } sinricpro_switch_device_t;
 
 /**
@@ -49,6 +56,7 @@ static bool switch_request_handler(const char *device_id,
         return true;
     }
 
+#if CONFIG_SINRICPRO_CAPABILITY_SETTING_CONTROLLER
     /* Try SettingController */
     if (sinricpro_setting_controller_handle_request(device->setting,
                                                       device_id,
@@ -57,6 +65,7 @@ static bool switch_request_handler(const char *device_id,
                                                       response_value)) {
         return true;
     }
+#endif
 
     ESP_LOGW(TAG, "Unhandled action: %s", action);
     return false;
@@ -77,7 +86,7 @@ sinricpro_device_handle_t sinricpro_switch_create(const char *device_id)
     }
 
     /* Allocate switch device */
-    sinricpro_switch_device_t *device = malloc(sizeof(sinricpro_switch_device_t));
+    sinricpro_switch_device_t *device = sinricpro_object_alloc(sizeof(sinricpro_switch_device_t));
     if (device == NULL) {
         ESP_LOGE(TAG, "Failed to allocate switch device");
         return NULL;
@@ -96,25 +105,29 @@ sinricpro_device_handle_t sinricpro_switch_create(const char *device_id)
     device->power_state = sinricpro_power_state_controller_create();
     if (device->power_state == NULL) {
         ESP_LOGE(TAG, "Failed to create PowerStateController");
-        free(device);
+        sinricpro_object_free(device);
         return NULL;
     }
 
+#if CONFIG_SINRICPRO_CAPABILITY_SETTING_CONTROLLER
     device->setting = sinricpro_setting_controller_create();
     if (device->setting == NULL) {
         ESP_LOGE(TAG, "Failed to create SettingController");
         sinricpro_power_state_controller_destroy(device->power_state);
-        free(device);
+        sinricpro_object_free(device);
         return NULL;
     }
+#endif
 
     /* Register device with core */
     esp_err_t ret = sinricpro_core_register_device(&device->base);
     if (ret != ESP_OK) {
         ESP_LOGE(TAG, "Failed to register device: %s", esp_err_to_name(ret));
+#if CONFIG_SINRICPRO_CAPABILITY_SETTING_CONTROLLER
         sinricpro_setting_controller_destroy(device->setting);
+#endif
         sinricpro_power_state_controller_destroy(device->power_state);
-        free(device);
+        sinricpro_object_free(device);
         return NULL;
     }
 
@@ -138,6 +151,7 @@ esp_err_t sinricpro_switch_on_power_state(sinricpro_device_handle_t handle,
                                                            user_data);
 }
 
+#if CONFIG_SINRICPRO_CAPABILITY_SETTING_CONTROLLER
 esp_err_t sinricpro_switch_on_setting(sinricpro_device_handle_t handle,
                                        sinricpro_setting_callback_t callback,
                                        void *user_data)
@@ -152,6 +166,7 @@ esp_err_t sinricpro_switch_on_setting(sinricpro_device_handle_t handle,
                                                        callback,
                                                        user_data);
 }
+#endif
 
 esp_err_t sinricpro_switch_send_power_state_event(sinricpro_device_handle_t handle,
                                                     bool state,
@@ -169,6 +184,7 @@ esp_err_t sinricpro_switch_send_power_state_event(sinricpro_device_handle_t hand
                                                          cause);
 }
 
+#if CONFIG_SINRICPRO_CAPABILITY_PUSH_NOTIFICATION
 esp_err_t sinricpro_switch_send_notification(sinricpro_device_handle_t handle,
                                               const char *message)
 {
@@ -180,6 +196,7 @@ esp_err_t sinricpro_switch_send_notification(sinricpro_device_handle_t handle,
 
     return sinricpro_send_push_notification(device->base.device_id, message);
 }
+#endif
 
 esp_err_t sinricpro_switch_delete(sinricpro_device_handle_t handle)
 {
@@ -196,16 +213,18 @@ esp_err_t sinricpro_switch_delete(sinricpro_device_handle_t handle)
     }
 
     /* Destroy capabilities */
+#if CONFIG_SINRICPRO_CAPABILITY_SETTING_CONTROLLER
     if (device->setting) {
         sinricpro_setting_controller_destroy(device->setting);
     }
+#endif
 
     if (device->power_state) {
         sinricpro_power_state_controller_destroy(device->power_state);
     }
 
     /* Free device */
-    free(device);
+    sinricpro_object_free(device);
 
     ESP_LOGI(TAG, "Switch device deleted");
 
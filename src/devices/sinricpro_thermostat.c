@@ -8,11 +8,20 @@
 
 #include "sinricpro_thermostat.h"
 #include "../core/sinricpro_device_internal.h"
+#include "../core/sinricpro_alloc.h"
+#if CONFIG_SINRICPRO_CAPABILITY_POWER_STATE_CONTROLLER
 #include "../capabilities/power_state_controller.h"
+#endif
 #include "../capabilities/thermostat_controller.h"
+#if CONFIG_SINRICPRO_CAPABILITY_TEMPERATURE_SENSOR
 #include "../capabilities/temperature_sensor.h"
+#endif
+#if CONFIG_SINRICPRO_CAPABILITY_SETTING_CONTROLLER
 #include "../capabilities/setting_controller.h"
+#endif
+#if CONFIG_SINRICPRO_CAPABILITY_PUSH_NOTIFICATION
 #include "../capabilities/push_notification.h"
+#endif
 #include <stdlib.h>
 #include <string.h>
 #include "esp_log.h"
@@ -21,10 +30,16 @@ static const char *TAG = "thermostat_device";
 
 typedef struct {
     sinricpro_device_t base;
+#if CONFIG_SINRICPRO_CAPABILITY_POWER_STATE_CONTROLLER
     sinricpro_power_state_controller_handle_t power_state_controller;
+#endif
     sinricpro_thermostat_controller_handle_t thermostat_controller;
+#if CONFIG_SINRICPRO_CAPABILITY_TEMPERATURE_SENSOR
     sinricpro_temperature_sensor_handle_t temperature_sensor;
+#endif
+#if CONFIG_SINRICPRO_CAPABILITY_SETTING_CONTROLLER
     sinricpro_setting_controller_handle_t setting_controller;
+#endif
 } sinricpro_thermostat_device_t;
 
 static bool thermostat_request_handler(
@@ -37,6 +52,7 @@ static bool thermostat_request_handler(
 {
     sinricpro_thermostat_device_t *dev = (sinricpro_thermostat_device_t *)user_data;
 
+#if CONFIG_SINRICPRO_CAPABILITY_POWER_STATE_CONTROLLER
     if (sinricpro_power_state_controller_handle_request(
             dev->power_state_controller,
             dev->base.device_id,
@@ -45,6 +61,7 @@ static bool thermostat_request_handler(
             response_value)) {
         return true;
     }
+#endif
 
     if (sinricpro_thermostat_controller_handle_request(
             dev->thermostat_controller,
@@ -55,6 +72,7 @@ static bool thermostat_request_handler(
         return true;
     }
 
+#if CONFIG_SINRICPRO_CAPABILITY_SETTING_CONTROLLER
     if (sinricpro_setting_controller_handle_request(
             dev->setting_controller,
             dev->base.device_id,
@@ -63,6 +81,7 @@ static bool thermostat_request_handler(
             response_value)) {
         return true;
     }
+#endif
 
     ESP_LOGW(TAG, "Unhandled action: %s", action);
     return false;
@@ -75,7 +94,7 @@ sinricpro_device_handle_t sinricpro_thermostat_create(const char *device_id)
         return NULL;
     }
 
-    sinricpro_thermostat_device_t *dev = malloc(sizeof(sinricpro_thermostat_device_t));
+    sinricpro_thermostat_device_t *dev = sinricpro_object_alloc(sizeof(sinricpro_thermostat_device_t));
     if (dev == NULL) {
         ESP_LOGE(TAG, "Failed to allocate thermostat device");
         return NULL;
@@ -83,21 +102,41 @@ sinricpro_device_handle_t sinricpro_thermostat_create(const char *device_id)
 
     memset(dev, 0, sizeof(sinricpro_thermostat_device_t));
 
+#if CONFIG_SINRICPRO_CAPABILITY_POWER_STATE_CONTROLLER
     dev->power_state_controller = sinricpro_power_state_controller_create();
+#endif
     dev->thermostat_controller = sinricpro_thermostat_controller_create();
+#if CONFIG_SINRICPRO_CAPABILITY_TEMPERATURE_SENSOR
     dev->temperature_sensor = sinricpro_temperature_sensor_capability_create();
+#endif
+#if CONFIG_SINRICPRO_CAPABILITY_SETTING_CONTROLLER
     dev->setting_controller = sinricpro_setting_controller_create();
-
-    if (dev->power_state_controller == NULL ||
-        dev->thermostat_controller == NULL ||
-        dev->temperature_sensor == NULL ||
-        dev->setting_controller == NULL) {
+#endif
+
+    bool failed = dev->thermostat_controller == NULL;
+#if CONFIG_SINRICPRO_CAPABILITY_POWER_STATE_CONTROLLER
+    failed = failed || dev->power_state_controller == NULL;
+#endif
+#if CONFIG_SINRICPRO_CAPABILITY_TEMPERATURE_SENSOR
+    failed = failed || dev->temperature_sensor == NULL;
+#endif
+#if CONFIG_SINRICPRO_CAPABILITY_SETTING_CONTROLLER
+    failed = failed || dev->setting_controller == NULL;
+#endif
+
+    if (failed) {
         ESP_LOGE(TAG, "Failed to create capabilities");
+#if CONFIG_SINRICPRO_CAPABILITY_POWER_STATE_CONTROLLER
         if (dev->power_state_controller) sinricpro_power_state_controller_destroy(dev->power_state_controller);
+#endif
         if (dev->thermostat_controller) sinricpro_thermostat_controller_destroy(dev->thermostat_controller);
+#if CONFIG_SINRICPRO_CAPABILITY_TEMPERATURE_SENSOR
         if (dev->temperature_sensor) sinricpro_temperature_sensor_destroy(dev->temperature_sensor);
+#endif
+#if CONFIG_SINRICPRO_CAPABILITY_SETTING_CONTROLLER
         if (dev->setting_controller) sinricpro_setting_controller_destroy(dev->setting_controller);
-        free(dev);
+#endif
+        sinricpro_object_free(dev);
         return NULL;
     }
 
@@ -110,11 +149,17 @@ sinricpro_device_handle_t sinricpro_thermostat_create(const char *device_id)
     esp_err_t ret = sinricpro_core_register_device(&dev->base);
     if (ret != ESP_OK) {
         ESP_LOGE(TAG, "Failed to register thermostat device");
+#if CONFIG_SINRICPRO_CAPABILITY_POWER_STATE_CONTROLLER
         sinricpro_power_state_controller_destroy(dev->power_state_controller);
+#endif
         sinricpro_thermostat_controller_destroy(dev->thermostat_controller);
+#if CONFIG_SINRICPRO_CAPABILITY_TEMPERATURE_SENSOR
         sinricpro_temperature_sensor_destroy(dev->temperature_sensor);
+#endif
+#if CONFIG_SINRICPRO_CAPABILITY_SETTING_CONTROLLER
         sinricpro_setting_controller_destroy(dev->setting_controller);
-        free(dev);
+#endif
+        sinricpro_object_free(dev);
         return NULL;
     }
 
@@ -122,6 +167,7 @@ sinricpro_device_handle_t sinricpro_thermostat_create(const char *device_id)
     return (sinricpro_device_handle_t)dev;
 }
 
+#if CONFIG_SINRICPRO_CAPABILITY_POWER_STATE_CONTROLLER
 esp_err_t sinricpro_thermostat_on_power_state(
     sinricpro_device_handle_t device,
     sinricpro_thermostat_power_state_callback_t callback,
@@ -138,6 +184,7 @@ esp_err_t sinricpro_thermostat_on_power_state(
         user_data
     );
 }
+#endif
 
 esp_err_t sinricpro_thermostat_on_thermostat_mode(
     sinricpro_device_handle_t device,
@@ -190,6 +237,7 @@ esp_err_t sinricpro_thermostat_on_adjust_target_temperature(
     );
 }
 
+#if CONFIG_SINRICPRO_CAPABILITY_POWER_STATE_CONTROLLER
 esp_err_t sinricpro_thermostat_send_power_state_event(
     sinricpro_device_handle_t device,
     bool state,
@@ -207,6 +255,7 @@ esp_err_t sinricpro_thermostat_send_power_state_event(
         cause
     );
 }
+#endif
 
 esp_err_t sinricpro_thermostat_send_mode_event(
     sinricpro_device_handle_t device,
@@ -244,6 +293,7 @@ esp_err_t sinricpro_thermostat_send_target_temperature_event(
     );
 }
 
+#if CONFIG_SINRICPRO_CAPABILITY_TEMPERATURE_SENSOR
 esp_err_t sinricpro_thermostat_send_temperature_event(
     sinricpro_device_handle_t device,
     float temperature,
@@ -263,3 +313,37 @@ esp_err_t sinricpro_thermostat_send_temperature_event(
         cause
     );
 }
+
+esp_err_t sinricpro_thermostat_set_temperature_report_policy(
+    sinricpro_device_handle_t device,
+    const sinricpro_report_policy_t *policy)
+{
+    if (device == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    sinricpro_thermostat_device_t *dev = (sinricpro_thermostat_device_t *)device;
+    return sinricpro_temperature_sensor_capability_set_report_policy(
+        dev->temperature_sensor,
+        policy
+    );
+}
+
+esp_err_t sinricpro_thermostat_push_temperature_sample(
+    sinricpro_device_handle_t device,
+    float temperature,
+    float humidity)
+{
+    if (device == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    sinricpro_thermostat_device_t *dev = (sinricpro_thermostat_device_t *)device;
+    return sinricpro_temperature_sensor_capability_push_sample(
+        dev->temperature_sensor,
+        dev->base.device_id,
+        temperature,
+        humidity
+    );
+}
+#endif
@@ -8,12 +8,21 @@
 
 #include "sinricpro_windowac.h"
 #include "../core/sinricpro_device_internal.h"
+#include "../core/sinricpro_alloc.h"
 #include "../capabilities/power_state_controller.h"
+#if CONFIG_SINRICPRO_CAPABILITY_RANGE_CONTROLLER
 #include "../capabilities/range_controller.h"
+#endif
 #include "../capabilities/thermostat_controller.h"
+#if CONFIG_SINRICPRO_CAPABILITY_TEMPERATURE_SENSOR
 #include "../capabilities/temperature_sensor.h"
+#endif
+#if CONFIG_SINRICPRO_CAPABILITY_SETTING_CONTROLLER
 #include "../capabilities/setting_controller.h"
+#endif
+#if CONFIG_SINRICPRO_CAPABILITY_PUSH_NOTIFICATION
 #include "../capabilities/push_notification.h"
+#endif
 #include <stdlib.h>
 #include <string.h>
 #include "esp_log.h"
@@ -23,10 +32,16 @@ static const char *TAG = "windowac_device";
 typedef struct {
     sinricpro_device_t base;
     sinricpro_power_state_controller_handle_t power_state_controller;
+#if CONFIG_SINRICPRO_CAPABILITY_RANGE_CONTROLLER
     sinricpro_range_controller_handle_t range_controller;
+#endif
     sinricpro_thermostat_controller_handle_t thermostat_controller;
+#if CONFIG_SINRICPRO_CAPABILITY_TEMPERATURE_SENSOR
     sinricpro_temperature_sensor_handle_t temperature_sensor;
+#endif
+#if CONFIG_SINRICPRO_CAPABILITY_SETTING_CONTROLLER
     sinricpro_setting_controller_handle_t setting_controller;
+#endif
 } sinricpro_windowac_device_t;
 
 static bool windowac_request_handler(
@@ -48,6 +63,7 @@ static bool windowac_request_handler(
         return true;
     }
 
+#if CONFIG_SINRICPRO_CAPABILITY_RANGE_CONTROLLER
     if (sinricpro_range_controller_handle_request(
             dev->range_controller,
             dev->base.device_id,
@@ -56,6 +72,7 @@ static bool windowac_request_handler(
             response_value)) {
         return true;
     }
+#endif
 
     if (sinricpro_thermostat_controller_handle_request(
             dev->thermostat_controller,
@@ -66,6 +83,7 @@ static bool windowac_request_handler(
         return true;
     }
 
+#if CONFIG_SINRICPRO_CAPABILITY_SETTING_CONTROLLER
     if (sinricpro_setting_controller_handle_request(
             dev->setting_controller,
             dev->base.device_id,
@@ -74,6 +92,7 @@ static bool windowac_request_handler(
             response_value)) {
         return true;
     }
+#endif
 
     ESP_LOGW(TAG, "Unhandled action: %s", action);
     return false;
@@ -86,7 +105,7 @@ sinricpro_device_handle_t sinricpro_windowac_create(const char *device_id)
         return NULL;
     }
 
-    sinricpro_windowac_device_t *dev = malloc(sizeof(sinricpro_windowac_device_t));
+    sinricpro_windowac_device_t *dev = sinricpro_object_alloc(sizeof(sinricpro_windowac_device_t));
     if (dev == NULL) {
         ESP_LOGE(TAG, "Failed to allocate window AC device");
         return NULL;
@@ -95,23 +114,42 @@ sinricpro_device_handle_t sinricpro_windowac_create(const char *device_id)
     memset(dev, 0, sizeof(sinricpro_windowac_device_t));
 
     dev->power_state_controller = sinricpro_power_state_controller_create();
+#if CONFIG_SINRICPRO_CAPABILITY_RANGE_CONTROLLER
     dev->range_controller = sinricpro_range_controller_create();
+#endif
     dev->thermostat_controller = sinricpro_thermostat_controller_create();
+#if CONFIG_SINRICPRO_CAPABILITY_TEMPERATURE_SENSOR
     dev->temperature_sensor = sinricpro_temperature_sensor_capability_create();
+#endif
+#if CONFIG_SINRICPRO_CAPABILITY_SETTING_CONTROLLER
     dev->setting_controller = sinricpro_setting_controller_create();
-
-    if (dev->power_state_controller == NULL ||
-        dev->range_controller == NULL ||
-        dev->thermostat_controller == NULL ||
-        dev->temperature_sensor == NULL ||
-        dev->setting_controller == NULL) {
+#endif
+
+    bool failed = dev->power_state_controller == NULL || dev->thermostat_controller == NULL;
+#if CONFIG_SINRICPRO_CAPABILITY_RANGE_CONTROLLER
+    failed = failed || dev->range_controller == NULL;
+#endif
+#if CONFIG_SINRICPRO_CAPABILITY_TEMPERATURE_SENSOR
+    failed = failed || dev->temperature_sensor == NULL;
+#endif
+#if CONFIG_SINRICPRO_CAPABILITY_SETTING_CONTROLLER
+    failed = failed || dev->setting_controller == NULL;
+#endif
+
+    if (failed) {
         ESP_LOGE(TAG, "Failed to create capabilities");
         if (dev->power_state_controller) sinricpro_power_state_controller_destroy(dev->power_state_controller);
+#if CONFIG_SINRICPRO_CAPABILITY_RANGE_CONTROLLER
         if (dev->range_controller) sinricpro_range_controller_destroy(dev->range_controller);
+#endif
         if (dev->thermostat_controller) sinricpro_thermostat_controller_destroy(dev->thermostat_controller);
+#if CONFIG_SINRICPRO_CAPABILITY_TEMPERATURE_SENSOR
         if (dev->temperature_sensor) sinricpro_temperature_sensor_destroy(dev->temperature_sensor);
+#endif
+#if CONFIG_SINRICPRO_CAPABILITY_SETTING_CONTROLLER
         if (dev->setting_controller) sinricpro_setting_controller_destroy(dev->setting_controller);
-        free(dev);
+#endif
+        sinricpro_object_free(dev);
         return NULL;
     }
 
@@ -125,11 +163,17 @@ sinricpro_device_handle_t sinricpro_windowac_create(const char *device_id)
     if (ret != ESP_OK) {
         ESP_LOGE(TAG, "Failed to register window AC device");
         sinricpro_power_state_controller_destroy(dev->power_state_controller);
+#if CONFIG_SINRICPRO_CAPABILITY_RANGE_CONTROLLER
         sinricpro_range_controller_destroy(dev->range_controller);
+#endif
         sinricpro_thermostat_controller_destroy(dev->thermostat_controller);
+#if CONFIG_SINRICPRO_CAPABILITY_TEMPERATURE_SENSOR
         sinricpro_temperature_sensor_destroy(dev->temperature_sensor);
+#endif
+#if CONFIG_SINRICPRO_CAPABILITY_SETTING_CONTROLLER
         sinricpro_setting_controller_destroy(dev->setting_controller);
-        free(dev);
+#endif
+        sinricpro_object_free(dev);
         return NULL;
     }
 
@@ -154,6 +198,7 @@ esp_err_t sinricpro_windowac_on_power_state(
     );
 }
 
+#if CONFIG_SINRICPRO_CAPABILITY_RANGE_CONTROLLER
 esp_err_t sinricpro_windowac_on_range_value(
     sinricpro_device_handle_t device,
     sinricpro_windowac_range_value_callback_t callback,
@@ -170,7 +215,9 @@ esp_err_t sinricpro_windowac_on_range_value(
         user_data
     );
 }
+#endif
 
+#if CONFIG_SINRICPRO_CAPABILITY_RANGE_CONTROLLER
 esp_err_t sinricpro_windowac_on_adjust_range_value(
     sinricpro_device_handle_t device,
     sinricpro_windowac_adjust_range_value_callback_t callback,
@@ -187,6 +234,7 @@ esp_err_t sinricpro_windowac_on_adjust_range_value(
         user_data
     );
 }
+#endif
 
 esp_err_t sinricpro_windowac_on_thermostat_mode(
     sinricpro_device_handle_t device,
@@ -257,6 +305,7 @@ esp_err_t sinricpro_windowac_send_power_state_event(
     );
 }
 
+#if CONFIG_SINRICPRO_CAPABILITY_RANGE_CONTROLLER
 esp_err_t sinricpro_windowac_send_range_value_event(
     sinricpro_device_handle_t device,
     int range_value,
@@ -274,6 +323,7 @@ esp_err_t sinricpro_windowac_send_range_value_event(
         cause
     );
 }
+#endif
 
 esp_err_t sinricpro_windowac_send_mode_event(
     sinricpro_device_handle_t device,
@@ -311,6 +361,7 @@ esp_err_t sinricpro_windowac_send_target_temperature_event(
     );
 }
 
+#if CONFIG_SINRICPRO_CAPABILITY_TEMPERATURE_SENSOR
 esp_err_t sinricpro_windowac_send_temperature_event(
     sinricpro_device_handle_t device,
     float temperature,
@@ -330,3 +381,37 @@ esp_err_t sinricpro_windowac_send_temperature_event(
         cause
     );
 }
+
+esp_err_t sinricpro_windowac_set_temperature_report_policy(
+    sinricpro_device_handle_t device,
+    const sinricpro_report_policy_t *policy)
+{
+    if (device == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    sinricpro_windowac_device_t *dev = (sinricpro_windowac_device_t *)device;
+    return sinricpro_temperature_sensor_capability_set_report_policy(
+        dev->temperature_sensor,
+        policy
+    );
+}
+
+esp_err_t sinricpro_windowac_push_temperature_sample(
+    sinricpro_device_handle_t device,
+    float temperature,
+    float humidity)
+{
+    if (device == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    sinricpro_windowac_device_t *dev = (sinricpro_windowac_device_t *)device;
+    return sinricpro_temperature_sensor_capability_push_sample(
+        dev->temperature_sensor,
+        dev->base.device_id,
+        temperature,
+        humidity
+    );
+}
+#endif
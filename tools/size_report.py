@@ -0,0 +1,122 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2019-2025 Sinric. All rights reserved.
+# Licensed under Creative Commons Attribution-Share Alike (CC BY-SA)
+#
+# This file is part of the SinricPro ESP-IDF component
+# (https://github.com/sinricpro/esp-idf)
+#
+"""Build examples with different device type selections and report sizes.
+
+For each configuration the example is built in its own build directory with
+an sdkconfig fragment, then the SinricPro component archive is measured with
+the toolchain's size utility and the application image with its file size.
+
+Usage (from an ESP-IDF environment, i.e. after export.sh):
+
+    python tools/size_report.py [--target esp32] [--only NAME ...]
+"""
+
+import argparse
+import glob
+import os
+import re
+import subprocess
+import sys
+
+REPO = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+
+DEVICE_TYPES = [
+    'SWITCH', 'LIGHT', 'DIMSWITCH', 'FAN', 'BLINDS', 'GARAGE_DOOR', 'LOCK',
+    'THERMOSTAT', 'WINDOWAC', 'TV', 'SPEAKER', 'MOTION_SENSOR',
+    'CONTACT_SENSOR', 'TEMPERATURE_SENSOR', 'AIR_QUALITY_SENSOR',
+    'POWER_SENSOR',
+]
+
+
+def only_devices(*keep):
+    """Fragment that disables every device type not in keep."""
+    return ['# CONFIG_SINRICPRO_DEVICE_%s is not set' % device
+            for device in DEVICE_TYPES if device not in keep]
+
+
+# name, example project, sdkconfig fragment
+CONFIGURATIONS = [
+    ('all', 'examples/switch', []),
+    ('switch', 'examples/switch', only_devices('SWITCH')),
+    ('light', 'examples/light', only_devices('LIGHT')),
+    ('motion_sensor', 'examples/motion_sensor', only_devices('MOTION_SENSOR')),
+]
+
+
+def run(cmd, **kwargs):
+    result = subprocess.run(cmd, stdout=subprocess.PIPE, stderr=subprocess.STDOUT,
+                            universal_newlines=True, **kwargs)
+    if result.returncode != 0:
+        sys.stderr.write(result.stdout)
+        raise SystemExit('command failed: %s' % ' '.join(cmd))
+    return result.stdout
+
+
+def size_tool(build_dir):
+    """The toolchain's size utility, derived from the C compiler in use."""
+    cache = open(os.path.join(build_dir, 'CMakeCache.txt')).read()
+    compiler = re.search(r'^CMAKE_C_COMPILER:\w+=(.+)$', cache, re.M).group(1)
+    return re.sub(r'gcc(\.exe)?$', r'size\1', compiler)
+
+
+def component_archive(build_dir):
+    """The archive that contains sinricpro_core.c."""
+    for archive in glob.glob(os.path.join(build_dir, 'esp-idf', '*', 'lib*.a')):
+        members = run(['ar', 't', archive])
+        if 'sinricpro_core.c.obj' in members:
+            return archive
+    raise SystemExit('SinricPro archive not found in %s' % build_dir)
+
+
+def measure(name, project, fragment, target):
+    project_dir = os.path.join(REPO, project)
+    build_dir = os.path.join(project_dir, 'build_size_%s' % name)
+    os.makedirs(build_dir, exist_ok=True)
+
+    defaults = os.path.join(build_dir, 'sdkconfig.size_defaults')
+    with open(defaults, 'w') as f:
+        f.write('CONFIG_IDF_TARGET="%s"\n' % target)
+        f.write('\n'.join(fragment) + '\n')
+
+    run(['idf.py', '-C', project_dir, '-B', build_dir,
+         '-DSDKCONFIG=%s' % os.path.join(build_dir, 'sdkconfig'),
+         '-DSDKCONFIG_DEFAULTS=%s' % defaults,
+         'build'])
+
+    totals = run([size_tool(build_dir), '-t', component_archive(build_dir)])
+    text, data, bss = (int(v) for v in totals.strip().splitlines()[-1].split()[:3])
+
+    images = [p for p in glob.glob(os.path.join(build_dir, '*.bin'))
+              if 'bootloader' not in p and 'partition' not in p]
+    image = os.path.getsize(images[0]) if images else 0
+
+    return text, data, bss, image
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument('--target', default='esp32')
+    parser.add_argument('--only', nargs='*', help='configurations to build')
+    args = parser.parse_args()
+
+    rows = []
+    for name, project, fragment in CONFIGURATIONS:
+        if args.only and name not in args.only:
+            continue
+        print('building %s (%s)...' % (name, project), file=sys.stderr)
+        rows.append((name,) + measure(name, project, fragment, args.target))
+
+    print('| Configuration | Component text | data | bss | Application image |')
+    print('|---------------|---------------:|-----:|----:|------------------:|')
+    for name, text, data, bss, image in rows:
+        print('| %s | %d | %d | %d | %d |' % (name, text, data, bss, image))
+
+
+if __name__ == '__main__':
+    main()